@@ -0,0 +1,93 @@
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+#include "alloc_counter.hpp"
+#include "bench_common.hpp"
+#include "cycle_arena.hpp"
+#include "market_data.hpp"
+
+// One GLOBAL_QUOTE pass without the network: build the request URL, receive the body in
+// curl-sized chunks, parse it into a QuoteRecord. The per-cycle heap version (URL
+// concatenated every pass, body in a std::string) versus a cached URL and a body drawn
+// from the cycle arena. Reports time and heap allocations per pass.
+
+static const std::string RESPONSE = R"({
+    "Global Quote": {
+        "01. symbol": "IBM",
+        "02. open": "226.6000",
+        "03. high": "228.6900",
+        "04. low": "225.7800",
+        "05. price": "227.4100",
+        "06. volume": "3415836",
+        "07. latest trading day": "2024-10-04",
+        "08. previous close": "226.0000",
+        "09. change": "1.4100",
+        "10. change percent": "0.6239%"
+    }
+})";
+
+static const std::string BASE_URL = "https://www.alphavantage.co/query";
+static const std::string SYMBOL = "IBM";
+static const std::string API_KEY = "demo";
+static constexpr size_t CHUNK = 128;
+
+template<class Str>
+static void receive(Str& body) {
+    for(size_t pos = 0; pos < RESPONSE.size(); pos += CHUNK) {
+        body.append(RESPONSE.data() + pos, std::min(CHUNK, RESPONSE.size() - pos));
+    }
+}
+
+static bool parse(std::string_view body, QuoteRecord& out) {
+    GlobalQuote quote;
+    if(!parseGlobalQuote(body, quote)) return false;
+    out = toQuoteRecord(quote);
+    return true;
+}
+
+int main() {
+    const size_t iters = 500'000;
+    QuoteRecord rec;
+
+    auto heapPass = [&] {
+        std::string url = BASE_URL + "?function=GLOBAL_QUOTE&symbol=" + SYMBOL + "&apikey=" + API_KEY;
+        std::string body;
+        receive(body);
+        doNotOptimize(url);
+        doNotOptimize(parse(body, rec));
+    };
+
+    const std::string url = BASE_URL + "?function=GLOBAL_QUOTE&symbol=" + SYMBOL + "&apikey=" + API_KEY;
+    CycleArena arena(64 * 1024);
+    auto arenaPass = [&] {
+        std::pmr::string body(&arena);
+        receive(body);
+        doNotOptimize(url);
+        doNotOptimize(parse(body, rec));
+        arena.reset();
+    };
+
+    std::printf("GLOBAL_QUOTE cycle, %zu byte body in %zu byte chunks\n", RESPONSE.size(), CHUNK);
+
+    uint64_t before = heapAllocations();
+    heapPass();
+    uint64_t heapAllocs = heapAllocations() - before;
+    reportNs("std::string per cycle", nsPerOp(heapPass, iters));
+
+    arenaPass();
+    before = heapAllocations();
+    arenaPass();
+    uint64_t arenaAllocs = heapAllocations() - before;
+    reportNs("cycle arena", nsPerOp(arenaPass, iters));
+
+    std::printf("  heap allocations per cycle: std::string %llu, arena %llu (arena high water %zu bytes)\n",
+                static_cast<unsigned long long>(heapAllocs), static_cast<unsigned long long>(arenaAllocs),
+                arena.highWater());
+
+    if(!rec.has(QuoteField::Price) || rec.price != 2274100 || arenaAllocs != 0) {
+        std::printf("arena cycle produced wrong result or allocated\n");
+        return 1;
+    }
+    return 0;
+}
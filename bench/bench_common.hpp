@@ -0,0 +1,56 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include <x86intrin.h>
+
+// Minimal helpers shared by the microbenchmarks in bench/.
+
+template<class T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void clobberMemory() {
+    asm volatile("" : : : "memory");
+}
+
+// Runs fn() iters times (after a short warm-up) and returns mean nanoseconds per call.
+template<class Fn>
+double nsPerOp(Fn&& fn, size_t iters) {
+    for(size_t i = 0; i < iters / 10 + 1; ++i) fn();
+    auto start = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < iters; ++i) fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(iters);
+}
+
+inline void reportNs(const char* name, double ns) {
+    std::printf("  %-34s %10.1f ns/op\n", name, ns);
+}
+
+// TSC ticks per nanosecond, measured against steady_clock over ~20ms.
+inline double tscPerNs() {
+    static const double ratio = [] {
+        auto t0 = std::chrono::steady_clock::now();
+        uint64_t c0 = __rdtsc();
+        while(std::chrono::steady_clock::now() - t0 < std::chrono::milliseconds(20)) {}
+        uint64_t c1 = __rdtsc();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+        return static_cast<double>(c1 - c0) / ns;
+    }();
+    return ratio;
+}
+
+// Prints p50/p99/p99.9/max of TSC-tick samples, converted to nanoseconds.
+inline void reportLatency(const char* name, std::vector<uint64_t>& ticks) {
+    if(ticks.empty()) return;
+    std::sort(ticks.begin(), ticks.end());
+    double scale = 1.0 / tscPerNs();
+    auto pct = [&](double p) { return ticks[std::min(ticks.size() - 1, static_cast<size_t>(p * ticks.size()))] * scale; };
+    std::printf("  %-28s p50 %8.1f  p99 %8.1f  p99.9 %9.1f  max %10.1f ns  (n=%zu)\n", name,
+                pct(0.50), pct(0.99), pct(0.999), ticks.back() * scale, ticks.size());
+}
@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+#include "alloc_counter.hpp"
+#include "async_io.hpp"
+#include "bench_common.hpp"
+#include "task.hpp"
+
+// Per-symbol poll-parse-quote cycles as coroutines. Each reactor thread owns SYMBOLS /
+// threads symbols and runs one coroutine per symbol: sleep until its next poll (random
+// 0-1 ms, standing in for the request), then update and requote the symbol. Reports the
+// cost of spawning a coroutine, reactor thread CPU time per cycle (timer dispatch, resume
+// and requote), frame pool usage, and heap allocations once every coroutine is running
+// (the target is 0).
+
+static constexpr size_t SYMBOLS = 20'000;
+static constexpr size_t CYCLES = 20;
+
+static int64_t threadCpuNs() {
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec;
+}
+
+struct SymbolState {
+    int64_t mid = 100'000'000;
+    int64_t bid = 0;
+    int64_t ask = 0;
+    uint32_t rng = 0;
+    uint64_t cycles = 0;
+};
+
+static uint32_t nextRandom(uint32_t& x) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+struct Shard {
+    Reactor reactor;
+    AsyncTimers timers{reactor};
+    std::vector<SymbolState> symbols;
+    size_t finished = 0;
+    double spawn_ns = 0;
+    double cpu_ns = 0;
+    uint64_t allocs_running = 0;
+    FramePoolStats frames;
+};
+
+static Task symbolLoop(Shard& shard, SymbolState& s) {
+    for(size_t i = 0; i < CYCLES; ++i) {
+        co_await shard.timers.sleepFor(std::chrono::microseconds(nextRandom(s.rng) % 1000));
+        int64_t move = static_cast<int64_t>(nextRandom(s.rng) % 2001) - 1000;
+        s.mid += move;
+        int64_t half_spread = s.mid / 4000;  // 5 bps
+        s.bid = s.mid - half_spread;
+        s.ask = s.mid + half_spread;
+        ++s.cycles;
+    }
+    if(++shard.finished == shard.symbols.size()) shard.reactor.stop();
+}
+
+static void runShard(Shard& shard, size_t first, size_t count) {
+    shard.symbols.resize(count);
+    for(size_t i = 0; i < count; ++i) shard.symbols[i].rng = static_cast<uint32_t>(first + i) * 2654435761u + 1;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for(SymbolState& s : shard.symbols) symbolLoop(shard, s).detach();
+    auto t1 = std::chrono::steady_clock::now();
+    uint64_t allocs_before = heapAllocations();
+    int64_t cpu_before = threadCpuNs();
+    shard.reactor.run();
+
+    shard.allocs_running = heapAllocations() - allocs_before;
+    shard.spawn_ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(count);
+    shard.cpu_ns = static_cast<double>(threadCpuNs() - cpu_before);
+    shard.frames = FramePool::thisThread().stats();
+}
+
+int main() {
+    size_t threads = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, 4);
+    std::vector<Shard> shards(threads);
+    std::vector<std::thread> workers;
+    for(size_t t = 0; t < threads; ++t) {
+        size_t first = SYMBOLS * t / threads;
+        size_t count = SYMBOLS * (t + 1) / threads - first;
+        workers.emplace_back([&shards, t, first, count] { runShard(shards[t], first, count); });
+    }
+    for(std::thread& w : workers) w.join();
+
+    std::printf("%zu symbol coroutines x %zu cycles on %zu reactor thread(s)\n", SYMBOLS, CYCLES, threads);
+    bool ok = true;
+    for(size_t t = 0; t < threads; ++t) {
+        const Shard& s = shards[t];
+        uint64_t cycles = 0;
+        for(const SymbolState& sym : s.symbols) cycles += sym.cycles;
+        ok = ok && cycles == s.symbols.size() * CYCLES && s.frames.live == 0 && s.allocs_running == 0;
+        std::printf("  thread %zu: spawn %6.1f ns/coroutine, %6.1f ns CPU/cycle, frames high water %lu in %lu chunk(s)"
+                    " (%lu oversized), heap allocs while running %lu\n",
+                    t, s.spawn_ns, s.cpu_ns / static_cast<double>(cycles), static_cast<unsigned long>(s.frames.high_water),
+                    static_cast<unsigned long>(s.frames.chunks), static_cast<unsigned long>(s.frames.oversized),
+                    static_cast<unsigned long>(s.allocs_running));
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "bench_common.hpp"
+#include "csv_decoder.hpp"
+#include "json_backend.hpp"
+
+// datatype=csv decoding: checks the recorded CSV bodies decode to the same records as
+// their JSON counterparts, then reports MB/s per delimiter kernel on a large body.
+
+#ifndef HFT_CORPUS_DIR
+#define HFT_CORPUS_DIR "bench/corpus"
+#endif
+
+static bool readFile(const std::string& path, std::string& out) {
+    std::ifstream in(path, std::ios::binary);
+    if(!in) return false;
+    out.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+// Header plus the body's data rows repeated up to roughly bytes.
+static std::string inflate(const std::string& csv, size_t bytes) {
+    size_t headerEnd = csv.find('\n') + 1;
+    std::string out = csv.substr(0, headerEnd);
+    out.reserve(bytes + csv.size());
+    while(out.size() < bytes) out.append(csv, headerEnd, std::string::npos);
+    return out;
+}
+
+int main(int argc, char* argv[]) {
+    std::string dir = argc > 1 ? argv[1] : HFT_CORPUS_DIR;
+    std::string bulkCsv, intradayCsv, bulkJson, intradayJson;
+    if(!readFile(dir + "/bulk_quotes.csv", bulkCsv) || !readFile(dir + "/intraday.csv", intradayCsv) ||
+       !readFile(dir + "/bulk_quotes.json", bulkJson) || !readFile(dir + "/intraday.json", intradayJson)) {
+        std::printf("cannot read corpus in %s\n", dir.c_str());
+        return 1;
+    }
+
+    // Correctness against the JSON decoders
+    ScannerJsonBackend json;
+    std::vector<QuoteRecord> refQuotes;
+    std::vector<Bar> refBars;
+    json.parseBulkQuotes(bulkJson, refQuotes);
+    json.parseIntraday(intradayJson, refBars);
+
+    QuoteColumns quotes;
+    IntradayColumns bars;
+    decodeBulkQuotesCsv(bulkCsv, quotes);
+    decodeIntradayCsv(intradayCsv, bars);
+
+    bool ok = quotes.size() == refQuotes.size() && bars.size() == refBars.size();
+    for(size_t i = 0; ok && i < quotes.size(); ++i) ok = quotes.record(i) == refQuotes[i];
+    for(size_t i = 0; ok && i < bars.size(); ++i) ok = bars.bar(i) == refBars[i];
+    std::printf("CSV decode (corpus matches JSON: %s)\n", ok ? "ok" : "MISMATCH");
+    std::printf("  bulk quotes: %zu bytes CSV vs %zu bytes JSON\n", bulkCsv.size(), bulkJson.size());
+    std::printf("  intraday:    %zu bytes CSV vs %zu bytes JSON\n", intradayCsv.size(), intradayJson.size());
+
+    const std::string bigBulk = inflate(bulkCsv, 64u << 20);
+    const std::string bigIntraday = inflate(intradayCsv, 64u << 20);
+    const int rounds = 3;
+
+    for(ScanIsa isa : {ScanIsa::Scalar, ScanIsa::Sse42, ScanIsa::Avx2}) {
+        if(!scanIsaSupported(isa)) continue;
+        BlockMaskFn mask = csvDelimiterMask(isa);
+
+        auto run = [&](const char* label, const std::string& body, bool bulk) {
+            size_t rows = 0;
+            auto start = std::chrono::steady_clock::now();
+            for(int r = 0; r < rounds; ++r) {
+                if(bulk) {
+                    QuoteColumns cols;
+                    rows = decodeBulkQuotesCsv(body, cols, mask);
+                    doNotOptimize(cols.price.data());
+                } else {
+                    IntradayColumns cols;
+                    rows = decodeIntradayCsv(body, cols, mask);
+                    doNotOptimize(cols.close.data());
+                }
+            }
+            double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::printf("  %-8s %-9s %8.1f MB/s  %6.1f Mrows/s\n", jsonScanner(isa).name, label,
+                        body.size() * rounds / secs / 1e6, rows * rounds / secs / 1e6);
+        };
+        run("bulk", bigBulk, true);
+        run("intraday", bigIntraday, false);
+    }
+    return ok ? 0 : 1;
+}
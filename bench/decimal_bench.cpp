@@ -0,0 +1,54 @@
+#include <charconv>
+#include <string>
+#include <string_view>
+
+#include "bench_common.hpp"
+#include "decimal.hpp"
+
+// Price string conversion: std::stod and std::from_chars versus fixed-point parsePrice.
+
+static const std::string_view PRICES[] = {
+    "227.4100", "226.6000", "228.6900", "225.7800", "1.4100", "0.0500", "4512.3300", "98.7654",
+    "13.0000", "301.2500", "87.1200", "1020.5000", "5.5500", "62.0100", "440.4400", "19.9900"
+};
+
+int main() {
+    const size_t iters = 2'000'000;
+    constexpr size_t n = sizeof(PRICES) / sizeof(PRICES[0]);
+
+    std::printf("Decimal parse, %zu prices per op\n", n);
+
+    reportNs("std::stod (string copy + locale)", nsPerOp([] {
+        double sum = 0;
+        for(std::string_view s : PRICES) {
+            try { sum += std::stod(std::string(s)); } catch(...) {}
+        }
+        doNotOptimize(sum);
+    }, iters) / n);
+
+    reportNs("std::from_chars<double>", nsPerOp([] {
+        double sum = 0;
+        for(std::string_view s : PRICES) {
+            double v = 0;
+            std::from_chars(s.data(), s.data() + s.size(), v);
+            sum += v;
+        }
+        doNotOptimize(sum);
+    }, iters) / n);
+
+    reportNs("parsePrice (int64 ticks)", nsPerOp([] {
+        int64_t sum = 0;
+        for(std::string_view s : PRICES) {
+            int64_t v = 0;
+            parsePrice(s, v);
+            sum += v;
+        }
+        doNotOptimize(sum);
+    }, iters) / n);
+
+    int64_t ticks = 0;
+    if(parsePrice("123.4500", ticks) != DecimalStatus::Ok || ticks != 1'234'500) return 1;
+    if(parsePrice("12x.45", ticks) != DecimalStatus::InvalidChar) return 1;
+    if(parsePrice("1.23456", ticks) != DecimalStatus::TooPrecise) return 1;
+    return 0;
+}
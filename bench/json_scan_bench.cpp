@@ -0,0 +1,96 @@
+#include <string>
+#include <vector>
+
+#include "bench_common.hpp"
+#include "json_scan.hpp"
+#include "quote_parser.hpp"
+
+// Structural scanner throughput (GB/s) for each kernel the CPU supports.
+
+static const char* QUOTE = R"({
+    "Global Quote": {
+        "01. symbol": "IBM",
+        "02. open": "226.6000",
+        "03. high": "228.6900",
+        "04. low": "225.7800",
+        "05. price": "227.4100",
+        "06. volume": "3415836",
+        "07. latest trading day": "2024-10-04",
+        "08. previous close": "226.0000",
+        "09. change": "1.4100",
+        "10. change percent": "0.6239%"
+    }
+}
+)";
+
+static const char* INTRADAY_BAR = R"(        "2024-10-04 19:55:00": {
+            "1. open": "226.7200",
+            "2. high": "226.8000",
+            "3. low": "226.7000",
+            "4. close": "226.8000",
+            "5. volume": "129"
+        },
+)";
+
+static std::string buildCorpus(size_t bytes) {
+    std::string out;
+    out.reserve(bytes + 4096);
+    while(out.size() < bytes) {
+        out += QUOTE;
+        for(int i = 0; i < 20; ++i) out += INTRADAY_BAR;
+    }
+    return out;
+}
+
+int main() {
+    const std::string corpus = buildCorpus(64u << 20);
+    const char* begin = corpus.data();
+    const char* end = begin + corpus.size();
+    const int rounds = 5;
+
+    std::printf("JSON structural scan over %.1f MB (active kernel: %s)\n",
+                corpus.size() / 1e6, jsonScanner().name);
+
+    size_t expected = 0;
+    for(ScanIsa isa : {ScanIsa::Scalar, ScanIsa::Sse42, ScanIsa::Avx2}) {
+        if(!scanIsaSupported(isa)) continue;
+        const JsonScanner& scan = jsonScanner(isa);
+
+        // Stage 1 only: classify every 64-byte block into a structural bitmask
+        size_t bits = 0;
+        auto classifyStart = std::chrono::steady_clock::now();
+        for(int r = 0; r < rounds; ++r) {
+            bits = 0;
+            for(const char* p = begin; p < end; p += 64) {
+                bits += __builtin_popcountll(scan.structuralMask(p, std::min<size_t>(64, static_cast<size_t>(end - p))));
+            }
+            doNotOptimize(bits);
+        }
+        double classifySecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - classifyStart).count();
+        std::printf("  %-8s classify    %7.2f GB/s\n", scan.name, corpus.size() * rounds / classifySecs / 1e9);
+
+        // Classification plus popping every token through the cursor
+        size_t count = 0;
+        auto start = std::chrono::steady_clock::now();
+        for(int r = 0; r < rounds; ++r) {
+            count = 0;
+            StructuralCursor cur(begin, end, scan);
+            for(const char* p = cur.next(); p < end; p = cur.next()) ++count;
+            doNotOptimize(count);
+        }
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if(expected == 0) expected = count;
+
+        std::printf("  %-8s tokens      %7.2f GB/s  (%zu tokens%s)\n", scan.name,
+                    corpus.size() * rounds / secs / 1e9, count, count == expected ? "" : ", MISMATCH");
+        if(count != expected) return 1;
+
+        GlobalQuote quote;
+        double ns = nsPerOp([&] {
+            bool ok = parseGlobalQuote(QUOTE, quote, scan);
+            doNotOptimize(ok);
+        }, 1'000'000);
+        std::printf("  %-8s GLOBAL_QUOTE %7.1f ns/response\n", scan.name, ns);
+    }
+    return 0;
+}
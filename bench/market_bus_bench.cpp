@@ -0,0 +1,139 @@
+#include <cstring>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <vector>
+
+#include "bench_common.hpp"
+#include "execution.hpp"
+#include "latency_histogram.hpp"
+#include "market_bus.hpp"
+
+// One publisher process, several consumer processes on the shared-memory market data bus.
+// The publisher sends bursts of BURST ticks (a bulk poll's worth) every GAP, stamped with
+// the publish time; each consumer records publish -> read latency. One consumer is
+// deliberately slow (it naps between reads): the producer flags it, laps it and it counts
+// the ticks it lost, while the others are unaffected. Consumers idle with Waiter in
+// HFT_WAIT_MODE, parked on the bus futex in sleep mode. Results come back through a shared
+// anonymous mapping.
+
+static constexpr size_t CAPACITY = 4096;
+static constexpr size_t BURST = 256;
+static constexpr size_t BURSTS = 400;
+static constexpr size_t TOTAL = BURST * BURSTS;
+static constexpr auto GAP = std::chrono::microseconds(500);
+static constexpr size_t FAST_CONSUMERS = 2;
+static constexpr size_t SLOW_NAP_EVERY = 64;           // slow consumer: 1 ms nap per 64 ticks
+static constexpr auto SLOW_NAP = std::chrono::milliseconds(1);
+
+struct ConsumerResult {
+    uint64_t received = 0;
+    uint64_t overruns = 0;
+    uint64_t slow_events = 0;
+    int64_t p50 = 0;
+    int64_t p99 = 0;
+    int64_t p999 = 0;
+    int64_t max = 0;
+    int ok = 0;
+};
+
+static int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void consume(const std::string& bus_name, size_t index, bool slow, WaitMode mode, ConsumerResult& out) {
+    MarketBusSubscriber sub;
+    std::string name = std::string(slow ? "slow" : "fast").append(std::to_string(index));
+    if(sub.open(bus_name, name) != 0) return;
+    Waiter waiter(mode);
+    LatencyHistogram hist;
+    auto ready = [&sub] { return sub.available() > 0; };
+    BusTick t;
+    uint64_t received = 0;
+    while(received + sub.overruns() < TOTAL) {
+        MarketBusSubscriber::Read r = sub.poll(t);
+        if(r == MarketBusSubscriber::Read::Empty) {
+            waiter.idle(sub, ready);
+            continue;
+        }
+        waiter.reset();
+        if(r != MarketBusSubscriber::Read::Tick) continue;
+        hist.record(nowNs() - t.stamp_ns);
+        ++received;
+        if(slow && received % SLOW_NAP_EVERY == 0) std::this_thread::sleep_for(SLOW_NAP);
+    }
+    out.received = received;
+    out.overruns = sub.overruns();
+    out.slow_events = sub.slowEvents();
+    out.p50 = hist.percentile(0.50);
+    out.p99 = hist.percentile(0.99);
+    out.p999 = hist.percentile(0.999);
+    out.max = hist.max();
+    out.ok = 1;
+}
+
+int main() {
+    ExecutionConfig cfg = ExecutionConfig::fromEnv();
+    std::string bus_name = "hft_bus_bench_" + std::to_string(getpid());
+    MarketBusPublisher pub;
+    if(int err = pub.open(bus_name, CAPACITY)) {
+        std::printf("Cannot create /dev/shm/%s: %s\n", bus_name.c_str(), std::strerror(err));
+        return 1;
+    }
+    size_t consumers = FAST_CONSUMERS + 1;
+    void* shared = mmap(nullptr, consumers * sizeof(ConsumerResult), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if(shared == MAP_FAILED) return 1;
+    ConsumerResult* results = new(shared) ConsumerResult[consumers];
+
+    std::vector<pid_t> children;
+    for(size_t i = 0; i < consumers; ++i) {
+        pid_t pid = fork();
+        if(pid == 0) {
+            consume(bus_name, i, i == FAST_CONSUMERS, cfg.mode, results[i]);
+            _exit(0);
+        }
+        if(pid > 0) children.push_back(pid);
+    }
+    // Every consumer attached before the first tick
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while(pub.consumers().size() < children.size() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    std::printf("Market data bus: %zu ticks in bursts of %zu every %ld us, %zu-slot ring, %zu fast + 1 slow consumer "
+                "processes, %s (%u hw threads)\n", TOTAL, BURST, static_cast<long>(GAP.count()), pub.capacity(),
+                FAST_CONSUMERS, toString(cfg.mode), std::thread::hardware_concurrency());
+    SymbolKey key;
+    SymbolKey::pack("AAPL", key);
+    auto next = std::chrono::steady_clock::now();
+    uint64_t publish_ticks = 0;
+    for(size_t b = 0; b < BURSTS; ++b) {
+        next += GAP;
+        std::this_thread::sleep_until(next);
+        for(size_t i = 0; i < BURST; ++i) {
+            BusTick t;
+            t.symbol = key;
+            t.last = static_cast<int64_t>(b * BURST + i);
+            uint64_t t0 = __rdtsc();
+            t.stamp_ns = nowNs();
+            pub.publish(t);
+            publish_ticks += __rdtsc() - t0;
+        }
+    }
+    reportNs("publish, per tick (incl. clock read)", static_cast<double>(publish_ticks) / tscPerNs() / TOTAL);
+
+    bool ok = true;
+    for(pid_t pid : children) waitpid(pid, nullptr, 0);
+    for(size_t i = 0; i < consumers; ++i) {
+        const ConsumerResult& r = results[i];
+        bool slow = i == FAST_CONSUMERS;
+        std::printf("  %s consumer %zu: %lu read, %lu lost to overruns, flagged slow %lu time(s); latency p50 %.1f  "
+                    "p99 %.1f  p99.9 %.1f  max %.1f us\n", slow ? "slow" : "fast", i,
+                    static_cast<unsigned long>(r.received), static_cast<unsigned long>(r.overruns),
+                    static_cast<unsigned long>(r.slow_events), r.p50 / 1000.0, r.p99 / 1000.0, r.p999 / 1000.0,
+                    r.max / 1000.0);
+        if(!slow) ok = ok && r.ok && r.received == TOTAL;
+    }
+    BusMapping::remove(bus_name);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+#include <random>
+#include <utility>
+
+#include "bench_common.hpp"
+#include "execution.hpp"
+#include "numa.hpp"
+#include "symbol_table.hpp"
+
+// Local versus remote placement of the strategy's working set. The thread is pinned to a
+// CPU of the first node; the state table and a pointer-chase buffer, both well past the
+// LLC, are moved to each node in turn with NumaPlacement, then measured with:
+//   strategy pass   computeQuotes over every row (streaming, bandwidth bound)
+//   pointer chase   dependent loads in random order (one miss per load, latency bound)
+// Remote rows only appear on a multi-node machine; on one node the local row is the baseline.
+
+static constexpr size_t SYMBOLS = 512 * 1024;     // 11 columns x 4 MB
+static constexpr size_t PASSES = 20;
+static constexpr size_t CHASE_LINES = 1 << 20;    // 64 MB
+static constexpr size_t CHASE_LOADS = 4'000'000;
+
+struct alignas(CACHE_LINE) Line {
+    uint64_t next;
+    uint64_t pad[7];
+};
+
+static double chaseNs(const AlignedArray<Line>& lines) {
+    uint64_t at = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < CHASE_LOADS; ++i) at = lines[at].next;
+    auto t1 = std::chrono::steady_clock::now();
+    doNotOptimize(at);
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / CHASE_LOADS;
+}
+
+static double strategyNs(SymbolStateTable& table, uint64_t& checksum) {
+    auto t0 = std::chrono::steady_clock::now();
+    for(size_t p = 0; p < PASSES; ++p) table.computeQuotes(0, SYMBOLS);
+    auto t1 = std::chrono::steady_clock::now();
+    checksum = 0;
+    for(size_t i = 0; i < SYMBOLS; ++i) checksum += static_cast<uint64_t>(table.our_bid[i]);
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / (PASSES * SYMBOLS);
+}
+
+int main() {
+    NumaTopology topo = NumaTopology::discover();
+    std::printf("%zu NUMA node(s)\n", topo.size());
+    for(const NumaNode& n : topo.nodes()) {
+        std::printf("  node %d: CPUs %s, distances", n.id, NumaTopology::formatCpuList(n.cpus).c_str());
+        for(int d : n.distance) std::printf(" %d", d);
+        std::printf("\n");
+    }
+    const NumaNode& home = topo.nodes().front();
+    if(!home.cpus.empty()) pinThisThread(home.cpus.front());
+    std::printf("Running on CPU %d, node %d\n", sched_getcpu(), currentNumaNode());
+
+    std::mt19937_64 rng(7);
+    SymbolStateTable table(SYMBOLS);
+    for(size_t i = 0; i < SYMBOLS; ++i) {
+        table.last[i] = 50'000 + static_cast<int64_t>(rng() % 5'000'000);
+        table.spread[i] = 500;
+    }
+    // One random cycle through every line (Sattolo), so each load depends on the last
+    AlignedArray<Line> lines(CHASE_LINES);
+    for(size_t i = 0; i < CHASE_LINES; ++i) lines[i].next = i;
+    for(size_t i = CHASE_LINES - 1; i > 0; --i) std::swap(lines[i].next, lines[rng() % i].next);
+
+    uint64_t expected = 0;
+    bool same = true;
+    for(const NumaNode& n : topo.nodes()) {
+        NumaPlacement placement;
+        placement.placeAll("table", table, n.id);
+        placement.place("chase", lines.data(), lines.bytes(), n.id);
+        size_t pages = 0;
+        size_t there = 0;
+        int error = 0;
+        for(const NumaPlacement::Entry& e : placement.entries()) {
+            pages += e.residency.pages;
+            there += e.residency.on_node;
+            if(e.error) error = e.error;
+        }
+
+        uint64_t checksum = 0;
+        double pass_ns = strategyNs(table, checksum);
+        double chase_ns = chaseNs(lines);
+        if(n.id == home.id) expected = checksum;
+        same = same && checksum == expected;
+
+        std::printf("Memory on node %d (%s, distance %d): %zu/%zu pages there%s%s\n", n.id,
+                    n.id == home.id ? "local" : "remote", topo.distance(home.id, n.id), there, pages,
+                    error ? ", mbind: " : "", error ? std::strerror(error) : "");
+        reportNs("strategy pass, per symbol", pass_ns);
+        reportNs("pointer chase, per load", chase_ns);
+    }
+    if(!topo.numa()) std::printf("  (one node: remote placement needs a multi-socket machine)\n");
+    return same && expected != 0 ? 0 : 1;
+}
@@ -0,0 +1,183 @@
+#include <cstring>
+#include <string>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <thread>
+#include <vector>
+
+#include "bench_common.hpp"
+#include "execution.hpp"
+#include "order_gateway.hpp"
+
+// Order round trip between a strategy process and a gateway process over the shared-memory
+// order gateway: the strategy sends a New and waits for its Ack (the gateway also fills
+// every FILL_EVERY-th order, so fills share the response ring). Then bursts of BURST orders
+// sent back to back, per order. Both processes idle with Waiter in each wait mode; spin and
+// hybrid need a core per process and are skipped on a single core. A Unix socketpair echo
+// of the same 64-byte message is the baseline the gateway replaces. Pinning via
+// HFT_STRATEGY_CPU (strategy) and HFT_FEED_CPU (gateway).
+
+static constexpr size_t ROUND_TRIPS = 20'000;
+static constexpr size_t WARMUP = 1'000;
+static constexpr size_t BURST = 64;
+static constexpr size_t BURSTS = 500;
+static constexpr uint64_t FILL_EVERY = 4;
+
+static int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Gateway process: acks every New, fills some, until its client has come and gone.
+static void serve(const std::string& name, WaitMode mode, int cpu) {
+    if(cpu >= 0) pinThisThread(cpu);
+    OrderGateway gw;
+    if(gw.open(name) != 0) return;
+    uint64_t next_id = 0;
+    auto onRequest = [&](size_t channel, const OrderRequest& req) {
+        OrderResponse r;
+        r.side = req.side;
+        r.client_order_id = req.client_order_id;
+        r.sent_ns = req.sent_ns;
+        if(req.kind == OrderRequestKind::Cancel) {
+            r.kind = OrderResponseKind::Cancelled;
+            gw.respond(channel, r);
+            return;
+        }
+        r.exchange_order_id = ++next_id;
+        r.gateway_ns = nowNs();
+        gw.respond(channel, r);
+        if(next_id % FILL_EVERY == 0) {
+            r.kind = OrderResponseKind::Fill;
+            r.price = req.price;
+            r.qty = req.qty;
+            gw.respond(channel, r);
+        }
+    };
+    Waiter waiter(mode);
+    auto ready = [&gw] { return gw.hasWork(); };
+    for(bool seen_client = false; !seen_client || gw.clients() > 0;) {
+        if(gw.poll(onRequest)) {
+            waiter.reset();
+            seen_client = true;
+            continue;
+        }
+        seen_client = seen_client || gw.clients() > 0;
+        waiter.idle(gw, ready);
+    }
+}
+
+// Waits for the Ack of order id; other responses (fills) are drained on the way.
+static bool awaitAck(OrderGatewayClient& client, Waiter& waiter, uint64_t id) {
+    auto ready = [&client] { return client.pendingResponses() > 0; };
+    OrderResponse r;
+    for(;;) {
+        if(!client.receive(r)) {
+            waiter.idle(client, ready);
+            continue;
+        }
+        waiter.reset();
+        if(r.kind == OrderResponseKind::Ack && r.client_order_id == id) return true;
+        if(r.kind == OrderResponseKind::Reject) return false;
+    }
+}
+
+static bool measureGateway(WaitMode mode, const ExecutionConfig& cfg) {
+    std::string name = "hft_gateway_bench_" + std::to_string(getpid());
+    pid_t gateway = fork();
+    if(gateway == 0) {
+        serve(name, mode, cfg.feed_cpu);
+        _exit(0);
+    }
+    if(cfg.strategy_cpu >= 0) pinThisThread(cfg.strategy_cpu);
+    OrderGatewayClient client;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while(client.open(name, "bench") != 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    bool ok = client.isOpen();
+
+    OrderRequest req;
+    SymbolKey::pack("AAPL", req.symbol);
+    req.price = Price{1'500'000};
+    req.qty = 100;
+    uint64_t id = 0;
+    std::vector<uint64_t> ticks;
+    ticks.reserve(ROUND_TRIPS);
+    Waiter waiter(mode);
+    for(size_t i = 0; ok && i < WARMUP + ROUND_TRIPS; ++i) {
+        req.client_order_id = ++id;
+        req.side = i % 2 ? Side::Sell : Side::Buy;
+        uint64_t t0 = __rdtsc();
+        req.sent_ns = nowNs();
+        ok = client.send(req) && awaitAck(client, waiter, id);
+        if(i >= WARMUP) ticks.push_back(__rdtsc() - t0);
+    }
+    std::string label = std::string("gateway, ").append(toString(mode));
+    reportLatency(label.c_str(), ticks);
+
+    ticks.clear();
+    for(size_t b = 0; ok && b < BURSTS; ++b) {
+        uint64_t t0 = __rdtsc();
+        uint64_t first = id + 1;
+        for(size_t i = 0; ok && i < BURST; ++i) {
+            req.client_order_id = ++id;
+            ok = client.send(req);
+        }
+        for(uint64_t i = first; ok && i <= id; ++i) ok = awaitAck(client, waiter, i);
+        ticks.push_back((__rdtsc() - t0) / BURST);
+    }
+    label.append(", burst/order");
+    reportLatency(label.c_str(), ticks);
+
+    client.close();
+    waitpid(gateway, nullptr, 0);
+    OrderGateway::remove(name);
+    return ok;
+}
+
+// Baseline: the same 64-byte request echoed back over a Unix socketpair.
+static bool measureSocket() {
+    int fds[2];
+    if(socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds) != 0) return false;
+    pid_t echo = fork();
+    if(echo == 0) {
+        ::close(fds[0]);
+        OrderRequest req;
+        while(read(fds[1], &req, sizeof(req)) == sizeof(req)) {
+            if(write(fds[1], &req, sizeof(req)) != sizeof(req)) break;
+        }
+        _exit(0);
+    }
+    ::close(fds[1]);
+    std::vector<uint64_t> ticks;
+    ticks.reserve(ROUND_TRIPS);
+    OrderRequest req;
+    bool ok = true;
+    for(size_t i = 0; ok && i < WARMUP + ROUND_TRIPS; ++i) {
+        req.client_order_id = i;
+        uint64_t t0 = __rdtsc();
+        ok = write(fds[0], &req, sizeof(req)) == sizeof(req) && read(fds[0], &req, sizeof(req)) == sizeof(req);
+        if(i >= WARMUP) ticks.push_back(__rdtsc() - t0);
+    }
+    reportLatency("socketpair echo (baseline)", ticks);
+    ::close(fds[0]);
+    waitpid(echo, nullptr, 0);
+    return ok;
+}
+
+int main() {
+    ExecutionConfig cfg = ExecutionConfig::fromEnv();
+    unsigned cores = std::thread::hardware_concurrency();
+    std::printf("Order round trip, strategy process <-> gateway process, %zu orders, %zu-byte messages (%u hw threads)\n",
+                ROUND_TRIPS, sizeof(OrderRequest), cores);
+    bool ok = measureSocket();
+    for(WaitMode mode : {WaitMode::Sleep, WaitMode::Hybrid, WaitMode::Spin}) {
+        if(mode != WaitMode::Sleep && cores < 2) {
+            std::string label = std::string("gateway, ").append(toString(mode));
+            std::printf("  %-28s skipped: needs a core per process\n", label.c_str());
+            continue;
+        }
+        ok = measureGateway(mode, cfg) && ok;
+    }
+    return ok ? 0 : 1;
+}
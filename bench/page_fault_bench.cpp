@@ -0,0 +1,64 @@
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "bench_common.hpp"
+#include "page_memory.hpp"
+
+// What low-jitter mode buys: first-touch page faults on freshly allocated heap memory
+// versus the prefaulted huge-page region, then random reads over the same footprint
+// (TLB reach of 4KB pages versus 2MB pages).
+
+static constexpr size_t BYTES = 64 * 1024 * 1024;
+static constexpr size_t READS = 4'000'000;
+
+static double touchNsPerPage(char* p, PageFaults& faults) {
+    PageFaults before = PageFaults::thisThread();
+    auto t0 = std::chrono::steady_clock::now();
+    for(size_t off = 0; off < BYTES; off += SMALL_PAGE) p[off] = 1;
+    auto t1 = std::chrono::steady_clock::now();
+    faults = PageFaults::thisThread() - before;
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / (BYTES / SMALL_PAGE);
+}
+
+static double randomReadNs(const char* p, const std::vector<uint32_t>& offsets) {
+    uint64_t sum = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for(uint32_t off : offsets) sum += static_cast<unsigned char>(p[off]);
+    auto t1 = std::chrono::steady_clock::now();
+    doNotOptimize(sum);
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(offsets.size());
+}
+
+int main() {
+    std::mt19937 rng(5);
+    std::vector<uint32_t> offsets(READS);
+    for(uint32_t& o : offsets) o = rng() % BYTES;
+
+    std::printf("%zu MB working set\n", BYTES / (1024 * 1024));
+
+    char* heap = static_cast<char*>(std::malloc(BYTES));
+    PageFaults heapFaults;
+    double heapTouch = touchNsPerPage(heap, heapFaults);
+    std::printf("  %-34s %10.1f ns/page  (%ld minor faults)\n", "heap, first touch", heapTouch, heapFaults.minor);
+
+    PageBacking backing = HugePageRegion::instance().reserve(BYTES);
+    char* region = static_cast<char*>(HugePageRegion::instance().allocate(BYTES, HUGE_PAGE));
+    if(!region) {
+        std::printf("  region unavailable, skipping\n");
+        std::free(heap);
+        return 0;
+    }
+    PageFaults regionFaults;
+    double regionTouch = touchNsPerPage(region, regionFaults);
+    std::printf("  %-34s %10.1f ns/page  (%ld minor faults)\n", "region (prefaulted), first touch", regionTouch,
+                regionFaults.minor);
+
+    reportNs("heap, random read", randomReadNs(heap, offsets));
+    reportNs("region, random read", randomReadNs(region, offsets));
+    std::printf("  region backing: %s\n", toString(backing));
+
+    std::free(heap);
+    // The prefaulted region must not fault again
+    return regionFaults.major == 0 && regionFaults.minor < 16 ? 0 : 1;
+}
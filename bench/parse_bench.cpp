@@ -0,0 +1,122 @@
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bench_common.hpp"
+#include "json_backend.hpp"
+
+// Runs every JSON backend over the recorded responses in bench/corpus, checks each one
+// against the jsoncpp DOM result and reports ns per response, MB/s and the fastest
+// correct backend per endpoint.
+
+#ifndef HFT_CORPUS_DIR
+#define HFT_CORPUS_DIR "bench/corpus"
+#endif
+
+enum class Endpoint { GlobalQuote, BulkQuotes, Intraday };
+
+struct CorpusFile {
+    const char* file;
+    Endpoint endpoint;
+};
+
+static bool readFile(const std::string& path, std::string& out) {
+    std::ifstream in(path, std::ios::binary);
+    if(!in) return false;
+    out.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+// Decodes body with backend; the result is flattened into a comparable form.
+struct Decoded {
+    bool ok = false;
+    std::vector<QuoteRecord> quotes;
+    std::vector<Bar> bars;
+
+    bool operator==(const Decoded& o) const { return ok == o.ok && quotes == o.quotes && bars == o.bars; }
+};
+
+static Decoded decode(JsonBackend& backend, Endpoint endpoint, const std::string& body) {
+    Decoded d;
+    switch(endpoint) {
+        case Endpoint::GlobalQuote: {
+            QuoteRecord rec;
+            d.ok = backend.parseGlobalQuote(body, rec);
+            if(d.ok) d.quotes.push_back(rec);
+            break;
+        }
+        case Endpoint::BulkQuotes:
+            d.ok = backend.parseBulkQuotes(body, d.quotes) > 0;
+            break;
+        case Endpoint::Intraday:
+            d.ok = backend.parseIntraday(body, d.bars) > 0;
+            break;
+    }
+    return d;
+}
+
+int main(int argc, char* argv[]) {
+    std::string dir = argc > 1 ? argv[1] : HFT_CORPUS_DIR;
+    const CorpusFile corpus[] = {
+        {"global_quote.json", Endpoint::GlobalQuote},
+        {"global_quote_note.json", Endpoint::GlobalQuote},
+        {"bulk_quotes.json", Endpoint::BulkQuotes},
+        {"bulk_quotes_literals.json", Endpoint::BulkQuotes},  // volume as a bare number
+        {"intraday.json", Endpoint::Intraday},
+    };
+    const JsonBackendKind kinds[] = {JsonBackendKind::Scanner, JsonBackendKind::JsonCpp, JsonBackendKind::OnDemand};
+
+    std::printf("JSON backend comparison (corpus: %s, scan kernel: %s)\n", dir.c_str(), jsonScanner().name);
+    bool allCorrect = true;
+
+    for(const CorpusFile& file : corpus) {
+        std::string body;
+        if(!readFile(dir + "/" + file.file, body)) {
+            std::printf("cannot read %s/%s\n", dir.c_str(), file.file);
+            return 1;
+        }
+
+        JsonCppBackend referenceBackend;
+        Decoded reference = decode(referenceBackend, file.endpoint, body);
+        std::printf("\n%s (%zu bytes, %zu records)\n", file.file, body.size(),
+                    reference.quotes.size() + reference.bars.size());
+
+        const char* fastest = nullptr;
+        double fastestNs = 0;
+        for(JsonBackendKind kind : kinds) {
+            std::unique_ptr<JsonBackend> backend = makeJsonBackend(kind);
+            bool correct = decode(*backend, file.endpoint, body) == reference;
+
+            size_t iters = std::max<size_t>(1000, 20'000'000 / body.size());
+            Decoded sink;
+            double ns = nsPerOp([&] {
+                sink.quotes.clear();
+                sink.bars.clear();
+                switch(file.endpoint) {
+                    case Endpoint::GlobalQuote: {
+                        QuoteRecord rec;
+                        sink.ok = backend->parseGlobalQuote(body, rec);
+                        doNotOptimize(rec);
+                        break;
+                    }
+                    case Endpoint::BulkQuotes: backend->parseBulkQuotes(body, sink.quotes); break;
+                    case Endpoint::Intraday: backend->parseIntraday(body, sink.bars); break;
+                }
+                clobberMemory();
+            }, iters);
+
+            std::printf("  %-9s %12.1f ns/response %9.1f MB/s  %s\n", backend->name(), ns,
+                        body.size() / ns * 1e3, correct ? "ok" : "MISMATCH");
+            allCorrect = allCorrect && correct;
+            if(correct && (!fastest || ns < fastestNs)) {
+                fastest = backend->name();
+                fastestNs = ns;
+            }
+        }
+        if(fastest) std::printf("  fastest correct: %s\n", fastest);
+    }
+    return allCorrect ? 0 : 1;
+}
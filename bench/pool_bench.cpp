@@ -0,0 +1,110 @@
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench_common.hpp"
+#include "object_pool.hpp"
+#include "orders.hpp"
+
+// Order churn: every step cancels a random resting order and places a replacement, the
+// pattern of a market maker requoting its book. new/delete against the pool, timed per
+// cancel+place pair. A background of long-lived strings keeps the heap fragmented, as it
+// would be in a running process. Finishes with a PaperExchange requote/match loop.
+
+static constexpr size_t RESTING = 512;
+static constexpr size_t STEPS = 1'000'000;
+
+int main() {
+    std::mt19937_64 rng(11);
+    std::vector<std::unique_ptr<std::string>> background;
+    for(size_t i = 0; i < 20'000; ++i) background.push_back(std::make_unique<std::string>(16 + rng() % 200, 'x'));
+
+    std::printf("Order cancel+place, %zu resting orders, %zu steps\n", RESTING, STEPS);
+
+    std::vector<size_t> victims(STEPS);
+    for(size_t& v : victims) v = rng() % RESTING;
+
+    {
+        std::vector<Order*> book(RESTING);
+        for(size_t i = 0; i < RESTING; ++i) book[i] = new Order{i, 0, Side::Buy, Price{100}, 100, 0};
+        std::vector<uint64_t> samples;
+        samples.reserve(STEPS);
+        for(size_t i = 0; i < STEPS; ++i) {
+            size_t v = victims[i];
+            uint64_t t0 = __rdtsc();
+            delete book[v];
+            book[v] = new Order{i, 0, Side::Sell, Price{static_cast<int64_t>(i)}, 100, 0};
+            uint64_t t1 = __rdtsc();
+            samples.push_back(t1 - t0);
+            if((i & 63) == 0) background[rng() % background.size()] = std::make_unique<std::string>(16 + rng() % 200, 'y');
+        }
+        reportLatency("new/delete", samples);
+        for(Order* o : book) delete o;
+    }
+
+    bool ok = true;
+    {
+        ObjectPool<Order> pool(RESTING + 1);
+        std::vector<Order*> book(RESTING);
+        for(size_t i = 0; i < RESTING; ++i) book[i] = pool.acquire(Order{i, 0, Side::Buy, Price{100}, 100, 0});
+        std::vector<uint64_t> samples;
+        samples.reserve(STEPS);
+        for(size_t i = 0; i < STEPS; ++i) {
+            size_t v = victims[i];
+            uint64_t t0 = __rdtsc();
+            pool.release(book[v]);
+            book[v] = pool.acquire(Order{i, 0, Side::Sell, Price{static_cast<int64_t>(i)}, 100, 0});
+            uint64_t t1 = __rdtsc();
+            samples.push_back(t1 - t0);
+            if((i & 63) == 0) background[rng() % background.size()] = std::make_unique<std::string>(16 + rng() % 200, 'y');
+        }
+        reportLatency("ObjectPool", samples);
+        PoolStats s = pool.stats();
+        std::printf("  %-28s in use %zu/%zu, high water %zu, exhausted %lu\n", "", s.in_use, s.capacity, s.high_water,
+                    static_cast<unsigned long>(s.exhausted));
+        ok = ok && s.in_use == RESTING && s.high_water == RESTING && s.exhausted == 0;
+
+        // Exhaustion is reported, not fatal
+        Order* extra = pool.acquire();
+        ok = ok && extra && !pool.acquire() && pool.stats().exhausted == 1;
+        pool.release(extra);
+        for(Order* o : book) pool.release(o);
+        ok = ok && pool.inUse() == 0;
+    }
+
+    {
+        const size_t symbols = 50;
+        SymbolStateTable table(symbols);
+        for(size_t i = 0; i < symbols; ++i) {
+            SymbolId id = table.add(std::string("S").append(std::to_string(i)), SpreadBps::fromBps(5.0), 100);
+            table.last[id] = 1'000'000 + static_cast<int64_t>(i) * 100;
+        }
+        table.computeQuotes();
+        PaperExchange exchange(PoolConfig::forSymbols(symbols), symbols);
+        exchange.requote(table, 0);
+
+        int64_t fills = 0;
+        double ns = nsPerOp([&] {
+            for(SymbolId id = 0; id < symbols; ++id) exchange.onTick(id, Price{table.last[id]}, 0);
+            exchange.match([&](const Fill& f) { fills += f.qty; });
+            exchange.requote(table, 0);
+            exchange.drainEvents([](const Event&) {});
+        }, 20'000);
+        std::printf("PaperExchange, %zu symbols per cycle\n", symbols);
+        reportNs("ticks + match + requote", ns);
+
+        // A trade through every bid fills all of them exactly once
+        for(SymbolId id = 0; id < symbols; ++id) exchange.onTick(id, Price{table.our_bid[id]}, 0);
+        int64_t before = fills;
+        exchange.match([&](const Fill& f) { fills += f.side == Side::Buy ? f.qty : 1'000'000; });
+        ok = ok && fills - before == static_cast<int64_t>(symbols) * 100 && fills == before + 5000;
+        ok = ok && exchange.orderStats().exhausted == 0 && exchange.orderStats().in_use == symbols;
+    }
+
+    if(!ok) {
+        std::printf("pool bookkeeping mismatch\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include <string>
+#include <string_view>
+
+#include "bench_common.hpp"
+#include "quote_parser.hpp"
+
+// GLOBAL_QUOTE parse cost: the old per-key rescan versus the single-pass parser.
+
+static const std::string RESPONSE = R"({
+    "Global Quote": {
+        "01. symbol": "IBM",
+        "02. open": "226.6000",
+        "03. high": "228.6900",
+        "04. low": "225.7800",
+        "05. price": "227.4100",
+        "06. volume": "3415836",
+        "07. latest trading day": "2024-10-04",
+        "08. previous close": "226.0000",
+        "09. change": "1.4100",
+        "10. change percent": "0.6239%"
+    }
+})";
+
+static const char* KEYS[] = {
+    "01. symbol", "02. open", "03. high", "04. low", "05. price", "06. volume",
+    "07. latest trading day", "08. previous close", "09. change", "10. change percent"
+};
+
+// The extraction lambda updateMarketPrice used before the single-pass parser.
+static std::string extractQuotedValue(const std::string& response, const std::string& key) {
+    std::string quotedKey = "\"" + key + "\"";
+    size_t keyPos = response.find(quotedKey);
+    if(keyPos == std::string::npos) return "";
+    size_t colonPos = response.find(':', keyPos + quotedKey.size());
+    if(colonPos == std::string::npos) return "";
+    size_t firstQuote = response.find('"', colonPos);
+    if(firstQuote == std::string::npos) return "";
+    size_t secondQuote = response.find('"', firstQuote + 1);
+    if(secondQuote == std::string::npos) return "";
+    return response.substr(firstQuote + 1, secondQuote - firstQuote - 1);
+}
+
+int main() {
+    const size_t iters = 2'000'000;
+
+    std::printf("GLOBAL_QUOTE parse (%zu byte response)\n", RESPONSE.size());
+
+    reportNs("rescan, 3 fields (price/low/high)", nsPerOp([] {
+        std::string price = extractQuotedValue(RESPONSE, KEYS[4]);
+        std::string low = extractQuotedValue(RESPONSE, KEYS[3]);
+        std::string high = extractQuotedValue(RESPONSE, KEYS[2]);
+        doNotOptimize(price);
+        doNotOptimize(low);
+        doNotOptimize(high);
+    }, iters));
+
+    reportNs("rescan, all 10 fields", nsPerOp([] {
+        for(const char* key : KEYS) {
+            std::string value = extractQuotedValue(RESPONSE, key);
+            doNotOptimize(value);
+        }
+    }, iters));
+
+    reportNs("single pass, all 10 fields", nsPerOp([] {
+        GlobalQuote quote;
+        bool ok = parseGlobalQuote(RESPONSE, quote);
+        doNotOptimize(ok);
+        doNotOptimize(quote);
+    }, iters));
+
+    GlobalQuote check;
+    if(!parseGlobalQuote(RESPONSE, check) || !check.complete() || check[QuoteField::Price] != "227.4100") {
+        std::printf("single pass parser produced wrong result\n");
+        return 1;
+    }
+    return 0;
+}
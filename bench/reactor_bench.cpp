@@ -0,0 +1,110 @@
+#include <atomic>
+#include <thread>
+
+#include "bench_common.hpp"
+#include "execution.hpp"
+#include "latency_histogram.hpp"
+#include "reactor.hpp"
+
+// Command and timer latency of the feed thread's event loop. A control thread posts a
+// command through an eventfd every GAP and the reactor records signal -> handler time,
+// in each wait mode; for comparison, the same commands picked up by a loop that checks a
+// flag between 1 ms sleeps (the shape of the old sleep-driven feed loop, minus its 12 s
+// sleep). Commands that arrive together are handled in one wake-up and counted once. The
+// last line is timerfd lateness: fire time -> handler on a GAP periodic timer.
+
+static constexpr size_t EVENTS = 2'000;
+static constexpr auto GAP = std::chrono::microseconds(500);
+
+static int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void report(const char* name, const LatencyHistogram& h) {
+    std::printf("  %-16s p50 %9.1f  p99 %9.1f  p99.9 %10.1f  max %11.1f ns  (n=%lu)\n", name,
+                static_cast<double>(h.percentile(0.50)), static_cast<double>(h.percentile(0.99)),
+                static_cast<double>(h.percentile(0.999)), static_cast<double>(h.max()),
+                static_cast<unsigned long>(h.count()));
+}
+
+// Posts EVENTS commands, stamping each into sent_ns just before notify().
+template<class Notify>
+static std::thread commandThread(std::atomic<int64_t>& sent_ns, Notify notify) {
+    return std::thread([&sent_ns, notify] {
+        auto next = std::chrono::steady_clock::now();
+        for(size_t i = 0; i < EVENTS; ++i) {
+            next += GAP;
+            std::this_thread::sleep_until(next);
+            sent_ns.store(nowNs(), std::memory_order_release);
+            notify();
+        }
+    });
+}
+
+static LatencyHistogram reactorCommands(WaitMode mode) {
+    Reactor reactor;
+    EventFd control;
+    std::atomic<int64_t> sent_ns{0};
+    LatencyHistogram hist;
+    size_t handled = 0;
+    reactor.add(control.fd(), EPOLLIN, [&](uint32_t) {
+        handled += control.drain();
+        hist.record(nowNs() - sent_ns.load(std::memory_order_acquire));
+        if(handled == EVENTS) reactor.stop();
+    });
+    std::thread sender = commandThread(sent_ns, [&] { control.signal(); });
+    reactor.run(mode);
+    sender.join();
+    return hist;
+}
+
+static LatencyHistogram sleepLoopCommands() {
+    std::atomic<int64_t> sent_ns{0};
+    std::atomic<size_t> pending{0};
+    LatencyHistogram hist;
+    std::thread sender = commandThread(sent_ns, [&] { pending.fetch_add(1, std::memory_order_release); });
+    for(size_t handled = 0; handled < EVENTS;) {
+        if(size_t n = pending.exchange(0, std::memory_order_acq_rel)) {
+            handled += n;
+            hist.record(nowNs() - sent_ns.load(std::memory_order_acquire));
+            continue;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    sender.join();
+    return hist;
+}
+
+static LatencyHistogram timerLateness() {
+    Reactor reactor;
+    TimerFd timer;
+    LatencyHistogram hist;
+    int64_t due_ns = nowNs() + std::chrono::nanoseconds(GAP).count();
+    reactor.add(timer.fd(), EPOLLIN, [&](uint32_t) {
+        uint64_t fired = timer.drain();
+        hist.record(nowNs() - due_ns);
+        due_ns += static_cast<int64_t>(fired) * std::chrono::nanoseconds(GAP).count();
+        if(hist.count() == EVENTS) reactor.stop();
+    });
+    timer.arm(GAP, GAP);
+    reactor.run();
+    return hist;
+}
+
+int main() {
+    std::printf("Command -> handler, %zu commands %ld us apart (%u hw threads)\n", EVENTS,
+                static_cast<long>(GAP.count()), std::thread::hardware_concurrency());
+    bool ok = true;
+    for(WaitMode mode : {WaitMode::Sleep, WaitMode::Hybrid, WaitMode::Spin}) {
+        LatencyHistogram h = reactorCommands(mode);
+        char name[32];
+        std::snprintf(name, sizeof(name), "reactor %s", toString(mode));
+        report(name, h);
+        ok = ok && h.count() > 0;
+    }
+    LatencyHistogram polled = sleepLoopCommands();
+    report("sleep 1ms loop", polled);
+    LatencyHistogram timer = timerLateness();
+    report("timerfd late", timer);
+    return ok && polled.count() > 0 && timer.count() == EVENTS ? 0 : 1;
+}
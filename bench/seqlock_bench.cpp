@@ -0,0 +1,84 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "bench_common.hpp"
+#include "quote_snapshot.hpp"
+#include "seqlock.hpp"
+
+// Reader latency for the quote snapshot while a writer publishes as fast as it can,
+// against the old layout of three independent atomics. The writer always publishes
+// last = n, bid = n - 1, ask = n + 1, so a reader can tell when it saw a torn mix.
+
+static constexpr size_t READS = 2'000'000;
+
+struct ThreeAtomics {
+    std::atomic<Price> last{Price{}};
+    std::atomic<Price> bid{Price{}};
+    std::atomic<Price> ask{Price{}};
+};
+
+static bool consistent(Price last, Price bid, Price ask) {
+    return bid.ticks == last.ticks - 1 && ask.ticks == last.ticks + 1;
+}
+
+int main() {
+    std::printf("Quote snapshot readers under a heavy writer (%u hw threads)\n", std::thread::hardware_concurrency());
+
+    {
+        Seqlock<QuoteSnapshot> lock(QuoteSnapshot{Price{1}, Price{0}, Price{2}, 0, 0});
+        std::atomic<bool> done{false};
+        std::thread writer([&] {
+            for(int64_t n = 2; !done.load(std::memory_order_relaxed); ++n) {
+                lock.store(QuoteSnapshot{Price{n}, Price{n - 1}, Price{n + 1}, n, n});
+            }
+        });
+
+        std::vector<uint64_t> samples;
+        samples.reserve(READS);
+        size_t torn = 0;
+        for(size_t i = 0; i < READS; ++i) {
+            uint64_t t0 = __rdtsc();
+            QuoteSnapshot snap = lock.load();
+            uint64_t t1 = __rdtsc();
+            samples.push_back(t1 - t0);
+            torn += !consistent(snap.last, snap.bid, snap.ask);
+        }
+        done = true;
+        writer.join();
+        reportLatency("seqlock snapshot", samples);
+        std::printf("  %-28s torn reads %zu, writes %lu\n", "", torn, static_cast<unsigned long>(lock.version()));
+    }
+
+    {
+        ThreeAtomics q;
+        q.last = Price{1};
+        q.ask = Price{2};
+        std::atomic<bool> done{false};
+        std::thread writer([&] {
+            for(int64_t n = 2; !done.load(std::memory_order_relaxed); ++n) {
+                q.last.store(Price{n});
+                q.bid.store(Price{n - 1});
+                q.ask.store(Price{n + 1});
+            }
+        });
+
+        std::vector<uint64_t> samples;
+        samples.reserve(READS);
+        size_t torn = 0;
+        for(size_t i = 0; i < READS; ++i) {
+            uint64_t t0 = __rdtsc();
+            Price last = q.last.load();
+            Price bid = q.bid.load();
+            Price ask = q.ask.load();
+            uint64_t t1 = __rdtsc();
+            samples.push_back(t1 - t0);
+            torn += !consistent(last, bid, ask);
+        }
+        done = true;
+        writer.join();
+        reportLatency("three independent atomics", samples);
+        std::printf("  %-28s torn reads %zu\n", "", torn);
+    }
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench_common.hpp"
+#include "static_config.hpp"
+#include "symbol_table.hpp"
+
+// Strategy pass over 10k symbols with parameters read per symbol at run time (the
+// default build) versus fixed at compile time (HFT_STATIC_CONFIG), for the default tick
+// rule and for an explicit penny tick.
+
+static constexpr size_t SYMBOLS = 10'000;
+
+struct DefaultTickConfig {
+    static constexpr std::string_view SYMBOLS[] = {"AAPL"};
+    static constexpr SpreadBps SPREAD{500};
+    static constexpr int64_t ORDER_SIZE = 100;
+    static constexpr TickSize TICK{0};
+};
+
+struct PennyConfig {
+    static constexpr std::string_view SYMBOLS[] = {"AAPL"};
+    static constexpr SpreadBps SPREAD{500};
+    static constexpr int64_t ORDER_SIZE = 100;
+    static constexpr TickSize TICK = PENNY;
+};
+
+static bool sameQuotes(const SymbolStateTable& a, const std::vector<int64_t>& bid, const std::vector<int64_t>& ask) {
+    for(size_t i = 0; i < a.size(); ++i) {
+        if(a.our_bid[i] != bid[i] || a.our_ask[i] != ask[i]) return false;
+    }
+    return true;
+}
+
+int main() {
+    std::mt19937_64 rng(42);
+    SymbolStateTable table(SYMBOLS);
+    for(size_t i = 0; i < SYMBOLS; ++i) {
+        SymbolId id = table.add(std::string("S").append(std::to_string(i)), DefaultTickConfig::SPREAD, DefaultTickConfig::ORDER_SIZE);
+        // Mix of sub-dollar and regular prices so both tick rules are exercised
+        table.last[id] = 5'000 + static_cast<int64_t>(rng() % 5'000'000);
+    }
+
+    std::printf("Strategy pass, %zu symbols\n", SYMBOLS);
+    bool ok = true;
+
+    double runtimeNs = nsPerOp([&] { table.computeQuotes(); doNotOptimize(table.our_bid[0]); }, 5000);
+    std::vector<int64_t> bid(table.our_bid.data(), table.our_bid.data() + SYMBOLS);
+    std::vector<int64_t> ask(table.our_ask.data(), table.our_ask.data() + SYMBOLS);
+    double staticNs = nsPerOp([&] { computeQuotesStatic<DefaultTickConfig>(table); doNotOptimize(table.our_bid[0]); }, 5000);
+    ok = ok && sameQuotes(table, bid, ask);
+    std::printf("  default tick rule:   runtime %8.2f ns/symbol, compile-time %8.2f ns/symbol (%.2fx)\n",
+                runtimeNs / SYMBOLS, staticNs / SYMBOLS, runtimeNs / staticNs);
+
+    for(size_t i = 0; i < SYMBOLS; ++i) table.tick[i] = PENNY.ticks;
+    runtimeNs = nsPerOp([&] { table.computeQuotes(); doNotOptimize(table.our_bid[0]); }, 5000);
+    bid.assign(table.our_bid.data(), table.our_bid.data() + SYMBOLS);
+    ask.assign(table.our_ask.data(), table.our_ask.data() + SYMBOLS);
+    staticNs = nsPerOp([&] { computeQuotesStatic<PennyConfig>(table); doNotOptimize(table.our_bid[0]); }, 5000);
+    ok = ok && sameQuotes(table, bid, ask);
+    std::printf("  fixed penny tick:    runtime %8.2f ns/symbol, compile-time %8.2f ns/symbol (%.2fx)\n",
+                runtimeNs / SYMBOLS, staticNs / SYMBOLS, runtimeNs / staticNs);
+
+    if(!ok) {
+        std::printf("compile-time quotes differ from runtime quotes\n");
+        return 1;
+    }
+    return 0;
+}
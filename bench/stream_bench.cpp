@@ -0,0 +1,103 @@
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "bench_common.hpp"
+#include "json_backend.hpp"
+#include "stream_decoder.hpp"
+
+// Streaming decode as driven from curl's write callback: the recorded bulk and intraday
+// bodies are fed in TCP-segment-sized chunks. Reports decode cost, how far into the body
+// the first record is published, and checks the output against the buffered scanner backend.
+
+#ifndef HFT_CORPUS_DIR
+#define HFT_CORPUS_DIR "bench/corpus"
+#endif
+
+static bool readFile(const std::string& path, std::string& out) {
+    std::ifstream in(path, std::ios::binary);
+    if(!in) return false;
+    out.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+template<class Decoder>
+static void feedChunks(Decoder& decoder, const std::string& body, size_t chunk) {
+    for(size_t off = 0; off < body.size(); off += chunk) {
+        decoder.feed(body.data() + off, std::min(chunk, body.size() - off));
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string dir = argc > 1 ? argv[1] : HFT_CORPUS_DIR;
+    std::string bulk, intraday;
+    if(!readFile(dir + "/bulk_quotes.json", bulk) || !readFile(dir + "/intraday.json", intraday)) {
+        std::printf("cannot read corpus in %s\n", dir.c_str());
+        return 1;
+    }
+
+    ScannerJsonBackend buffered;
+    std::vector<QuoteRecord> refQuotes;
+    std::vector<Bar> refBars;
+    buffered.parseBulkQuotes(bulk, refQuotes);
+    buffered.parseIntraday(intraday, refBars);
+
+    std::printf("Streaming decode (%s)\n", jsonScanner().name);
+    bool ok = true;
+
+    for(size_t chunk : {size_t(64), size_t(1448), size_t(16384)}) {
+        std::vector<QuoteRecord> quotes;
+        size_t fedAtFirst = 0, fed = 0;
+        StreamingJsonDecoder bulkDecoder([&](const QuoteRecord& rec) {
+            if(quotes.empty()) fedAtFirst = fed;
+            quotes.push_back(rec);
+        });
+        for(size_t off = 0; off < bulk.size(); off += chunk) {
+            size_t n = std::min(chunk, bulk.size() - off);
+            fed += n;
+            bulkDecoder.feed(bulk.data() + off, n);
+        }
+        bool same = quotes == refQuotes && bulkDecoder.finished();
+        ok = ok && same;
+        size_t firstAt = fedAtFirst;
+
+        double ns = nsPerOp([&] {
+            quotes.clear();
+            bulkDecoder.reset();
+            feedChunks(bulkDecoder, bulk, chunk);
+        }, 2000);
+        std::printf("  bulk     chunk %5zu: %9.1f ns/response, first quote after %5zu of %zu bytes  %s\n",
+                    chunk, ns, firstAt, bulk.size(), same ? "ok" : "MISMATCH");
+
+        std::vector<Bar> bars;
+        fed = 0;
+        StreamingJsonDecoder barDecoder([&](const Bar& bar) {
+            if(bars.empty()) fedAtFirst = fed;
+            bars.push_back(bar);
+        });
+        for(size_t off = 0; off < intraday.size(); off += chunk) {
+            size_t n = std::min(chunk, intraday.size() - off);
+            fed += n;
+            barDecoder.feed(intraday.data() + off, n);
+        }
+        same = bars == refBars && barDecoder.finished();
+        ok = ok && same;
+        firstAt = fedAtFirst;
+
+        ns = nsPerOp([&] {
+            bars.clear();
+            barDecoder.reset();
+            feedChunks(barDecoder, intraday, chunk);
+        }, 2000);
+        std::printf("  intraday chunk %5zu: %9.1f ns/response, first bar after   %5zu of %zu bytes  %s\n",
+                    chunk, ns, firstAt, intraday.size(), same ? "ok" : "MISMATCH");
+    }
+
+    double bufferedNs = nsPerOp([&] {
+        refQuotes.clear();
+        buffered.parseBulkQuotes(bulk, refQuotes);
+    }, 2000);
+    std::printf("  bulk     buffered:    %9.1f ns/response (after full download)\n", bufferedNs);
+    return ok ? 0 : 1;
+}
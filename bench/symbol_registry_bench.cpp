@@ -0,0 +1,73 @@
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "bench_common.hpp"
+#include "symbol_registry.hpp"
+
+// Ticker lookup from wire data: std::unordered_map<std::string, SymbolId> (a std::string built
+// per lookup, as the previous table did) versus the interned registry.
+
+static constexpr size_t SYMBOLS = 10'000;
+static constexpr size_t LOOKUPS = 4096;
+
+int main() {
+    std::mt19937_64 rng(7);
+    std::vector<std::string> tickers;
+    for(size_t i = 0; i < SYMBOLS; ++i) {
+        std::string t;
+        size_t len = 1 + rng() % 5;
+        for(size_t c = 0; c < len; ++c) t.push_back(static_cast<char>('A' + rng() % 26));
+        t += std::to_string(i % 10);
+        tickers.push_back(t);
+    }
+
+    SymbolRegistry registry(SYMBOLS);
+    std::unordered_map<std::string, SymbolId> map;
+    for(const std::string& t : tickers) {
+        SymbolId id = registry.intern(t);
+        map.emplace(t, id);
+    }
+
+    // Wire data: views into a response buffer
+    std::string wire;
+    std::vector<std::string_view> views;
+    std::vector<size_t> offsets;
+    for(size_t i = 0; i < LOOKUPS; ++i) {
+        const std::string& t = tickers[rng() % tickers.size()];
+        offsets.push_back(wire.size());
+        wire += t;
+        wire += ',';
+    }
+    for(size_t i = 0; i < LOOKUPS; ++i) {
+        size_t end = wire.find(',', offsets[i]);
+        views.emplace_back(wire.data() + offsets[i], end - offsets[i]);
+    }
+
+    std::printf("Symbol lookup, %zu interned, %zu lookups per op (%zu unique)\n", SYMBOLS, LOOKUPS, registry.size());
+
+    double mapNs = nsPerOp([&] {
+        uint64_t sum = 0;
+        for(std::string_view v : views) {
+            auto it = map.find(std::string(v));
+            sum += it == map.end() ? 0 : it->second;
+        }
+        doNotOptimize(sum);
+    }, 2000) / LOOKUPS;
+
+    double regNs = nsPerOp([&] {
+        uint64_t sum = 0;
+        for(std::string_view v : views) sum += registry.find(v);
+        doNotOptimize(sum);
+    }, 2000) / LOOKUPS;
+
+    reportNs("unordered_map<std::string>", mapNs);
+    reportNs("SymbolRegistry (flat, packed key)", regNs);
+
+    for(std::string_view v : views) {
+        if(map.at(std::string(v)) != registry.find(v) || registry.name(registry.find(v)) != v) return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include <atomic>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench_common.hpp"
+#include "fixed_point.hpp"
+#include "symbol_table.hpp"
+
+// Full-universe update pass at 10k symbols: apply a new price to every symbol and
+// recompute our bid/ask, over the SoA table versus one heap object per symbol (the
+// MarketMaker-per-symbol layout).
+
+static constexpr size_t SYMBOLS = 10'000;
+
+// Per-symbol object as MarketMaker holds its state: a name and scalar atomics.
+struct SymbolObject {
+    std::string symbol;
+    std::atomic<Price> last{Price{}};
+    std::atomic<Price> bid{Price{}};
+    std::atomic<Price> ask{Price{}};
+    SpreadBps spread = SpreadBps::fromBps(5.0);
+    int64_t order_size = 100;
+    std::atomic<Price> our_bid{Price{}};
+    std::atomic<Price> our_ask{Price{}};
+};
+
+int main() {
+    std::mt19937_64 rng(42);
+    std::vector<int64_t> prices(SYMBOLS);
+    for(int64_t& p : prices) p = 50'000 + static_cast<int64_t>(rng() % 5'000'000);
+
+    SymbolStateTable table(SYMBOLS);
+    std::vector<std::unique_ptr<SymbolObject>> objects;
+    std::vector<std::unique_ptr<char[]>> filler;
+    for(size_t i = 0; i < SYMBOLS; ++i) {
+        std::string sym = std::string("S").append(std::to_string(i));
+        table.add(sym, SpreadBps::fromBps(5.0), 100);
+        objects.push_back(std::make_unique<SymbolObject>());
+        objects.back()->symbol = sym;
+        // Interleave unrelated allocations the way a long-running process scatters objects
+        filler.push_back(std::make_unique<char[]>(64 + rng() % 512));
+    }
+    std::shuffle(objects.begin(), objects.end(), rng);
+
+    std::printf("Full-universe update pass, %zu symbols\n", SYMBOLS);
+    int64_t bump = 0;
+
+    double soa = nsPerOp([&] {
+        ++bump;
+        for(size_t i = 0; i < table.size(); ++i) table.last[i] = prices[i] + (bump & 7);
+        table.computeQuotes();
+        doNotOptimize(table.our_bid[SYMBOLS - 1]);
+    }, 2000);
+
+    double aos = nsPerOp([&] {
+        ++bump;
+        for(size_t i = 0; i < objects.size(); ++i) {
+            SymbolObject& o = *objects[i];
+            Price mid{prices[i] + (bump & 7)};
+            o.last.store(mid);
+            QuotePair q = quoteAround(mid, o.spread, defaultTickSize(mid));
+            o.our_bid.store(q.bid);
+            o.our_ask.store(q.ask);
+        }
+        doNotOptimize(objects[0]->our_bid);
+    }, 2000);
+
+    std::printf("  %-28s %10.1f ns/pass %6.2f ns/symbol\n", "SoA state table", soa, soa / SYMBOLS);
+    std::printf("  %-28s %10.1f ns/pass %6.2f ns/symbol\n", "heap object per symbol", aos, aos / SYMBOLS);
+
+    // Same answers from both layouts
+    for(size_t i = 0; i < SYMBOLS; ++i) {
+        Price mid{table.last[i]};
+        if(table.ourQuote(static_cast<SymbolId>(i)).bid != quoteAround(mid, SpreadBps::fromBps(5.0), defaultTickSize(mid)).bid) {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include <map>
+#include <vector>
+
+#include "bench_common.hpp"
+#include "timer_wheel.hpp"
+
+// 100k active per-symbol timers, hierarchical wheel versus a sorted container
+// (std::multimap, the usual "ordered deadlines" structure).
+//   reschedule: move a random timer to a new deadline (a backoff reset or requote)
+//   churn:      advance time tick by tick; every timer that fires re-arms itself one
+//               period later (per-symbol poll schedule), cost per timer fired
+// Both structures see the same random sequences and must fire the same number of timers.
+
+static constexpr size_t TIMERS = 100'000;
+static constexpr uint64_t MAX_DELAY = 50'000;
+static constexpr size_t RESCHEDULES = 1'000'000;
+static constexpr uint64_t CHURN_TICKS = 200'000;
+
+static uint64_t nextRandom(uint64_t& x) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return x;
+}
+
+struct WheelTimer : TimerNode {
+    TimerWheel* wheel = nullptr;
+    uint64_t period = 0;
+    uint64_t* fired = nullptr;
+};
+
+struct MapTimer {
+    uint64_t period = 0;
+};
+
+struct Result {
+    double reschedule_ns;
+    double churn_ns;
+    uint64_t fired;
+};
+
+static Result runWheel() {
+    std::vector<WheelTimer> timers(TIMERS);   // outlives the wheel, which unlinks them
+    TimerWheel wheel;
+    uint64_t rng = 88172645463325252ull;
+    uint64_t fired = 0;
+    for(WheelTimer& t : timers) {
+        t.fire = [](TimerNode* n) {
+            WheelTimer* t = static_cast<WheelTimer*>(n);
+            ++*t->fired;
+            t->wheel->schedule(*t, t->wheel->now() + t->period);
+        };
+        t.wheel = &wheel;
+        t.fired = &fired;
+        t.period = 1 + nextRandom(rng) % MAX_DELAY;
+        wheel.schedule(t, t.period);
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < RESCHEDULES; ++i) {
+        WheelTimer& t = timers[nextRandom(rng) % TIMERS];
+        wheel.schedule(t, wheel.now() + 1 + nextRandom(rng) % MAX_DELAY);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    for(uint64_t tick = 1; tick <= CHURN_TICKS; ++tick) wheel.advance(tick);
+    auto t2 = std::chrono::steady_clock::now();
+    return {std::chrono::duration<double, std::nano>(t1 - t0).count() / RESCHEDULES,
+            std::chrono::duration<double, std::nano>(t2 - t1).count() / static_cast<double>(fired), fired};
+}
+
+static Result runMap() {
+    using Deadlines = std::multimap<uint64_t, MapTimer*>;
+    Deadlines deadlines;
+    std::vector<MapTimer> timers(TIMERS);
+    std::vector<Deadlines::iterator> pos(TIMERS);
+    uint64_t rng = 88172645463325252ull;
+    uint64_t now = 0;
+    uint64_t fired = 0;
+    for(size_t i = 0; i < TIMERS; ++i) {
+        timers[i].period = 1 + nextRandom(rng) % MAX_DELAY;
+        pos[i] = deadlines.emplace(timers[i].period, &timers[i]);
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < RESCHEDULES; ++i) {
+        size_t k = nextRandom(rng) % TIMERS;
+        deadlines.erase(pos[k]);
+        pos[k] = deadlines.emplace(now + 1 + nextRandom(rng) % MAX_DELAY, &timers[k]);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    for(now = 1; now <= CHURN_TICKS; ++now) {
+        while(!deadlines.empty() && deadlines.begin()->first <= now) {
+            MapTimer* t = deadlines.begin()->second;
+            deadlines.erase(deadlines.begin());
+            pos[static_cast<size_t>(t - timers.data())] = deadlines.emplace(now + t->period, t);
+            ++fired;
+        }
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    return {std::chrono::duration<double, std::nano>(t1 - t0).count() / RESCHEDULES,
+            std::chrono::duration<double, std::nano>(t2 - t1).count() / static_cast<double>(fired), fired};
+}
+
+int main() {
+    std::printf("%zu active timers, delays 1-%lu ticks\n", TIMERS, static_cast<unsigned long>(MAX_DELAY));
+    Result wheel = runWheel();
+    Result map = runMap();
+    reportNs("reschedule: timer wheel", wheel.reschedule_ns);
+    reportNs("reschedule: std::multimap", map.reschedule_ns);
+    reportNs("churn per fire: timer wheel", wheel.churn_ns);
+    reportNs("churn per fire: std::multimap", map.churn_ns);
+    std::printf("  fired %lu timers over %lu ticks\n", static_cast<unsigned long>(wheel.fired),
+                static_cast<unsigned long>(CHURN_TICKS));
+    return wheel.fired == map.fired && wheel.fired > 0 ? 0 : 1;
+}
@@ -0,0 +1,79 @@
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "bench_common.hpp"
+#include "execution.hpp"
+#include "latency_histogram.hpp"
+#include "market_tick.hpp"
+#include "spsc_ring.hpp"
+
+// Wake-up-to-handle latency of the strategy loop in each wait mode. A producer publishes
+// a tick every GAP through the SPSC ring; the consumer idles with Waiter between ticks and
+// records pushed -> popped time. Sleep and hybrid run twice: sleeping in fixed steps, and
+// parked on a Doorbell the producer rings after each push (what the market maker does).
+// Optional pinning via HFT_FEED_CPU / HFT_STRATEGY_CPU, as in the market maker. Spin mode
+// needs a core of its own to be meaningful.
+
+static constexpr size_t EVENTS = 5'000;
+static constexpr auto GAP = std::chrono::microseconds(200);
+
+static int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static LatencyHistogram measure(WaitMode mode, bool doorbell, const ExecutionConfig& cfg) {
+    SpscRing<MarketTick> ring(256);
+    Doorbell bell;
+    LatencyHistogram hist;
+    std::thread producer([&] {
+        if(cfg.feed_cpu >= 0) pinThisThread(cfg.feed_cpu);
+        auto next = std::chrono::steady_clock::now();
+        for(size_t i = 0; i < EVENTS; ++i) {
+            next += GAP;
+            std::this_thread::sleep_until(next);
+            MarketTick t;
+            t.decoded_ns = nowNs();
+            ring.push(t);
+            if(doorbell) bell.ring();
+        }
+    });
+    if(cfg.strategy_cpu >= 0) pinThisThread(cfg.strategy_cpu);
+    Waiter waiter(mode);
+    MarketTick t;
+    auto ready = [&ring] { return ring.depth() > 0; };
+    for(size_t got = 0; got < EVENTS;) {
+        if(!ring.pop(t)) {
+            if(doorbell) waiter.idle(bell, ready);
+            else waiter.idle();
+            continue;
+        }
+        waiter.reset();
+        hist.record(nowNs() - t.decoded_ns);
+        ++got;
+    }
+    producer.join();
+    return hist;
+}
+
+int main() {
+    ExecutionConfig cfg = ExecutionConfig::fromEnv();
+    std::printf("Wake-up to handle, %zu ticks %ld us apart (%u hw threads)\n", EVENTS,
+                static_cast<long>(GAP.count()), std::thread::hardware_concurrency());
+    bool ok = true;
+    struct Variant {
+        WaitMode mode;
+        bool doorbell;
+    };
+    for(Variant v : {Variant{WaitMode::Sleep, false}, Variant{WaitMode::Sleep, true}, Variant{WaitMode::Hybrid, false},
+                     Variant{WaitMode::Hybrid, true}, Variant{WaitMode::Spin, false}}) {
+        LatencyHistogram h = measure(v.mode, v.doorbell, cfg);
+        std::string name = std::string(toString(v.mode)).append(v.doorbell ? " + doorbell" : "");
+        std::printf("  %-17s p50 %8.1f  p99 %8.1f  p99.9 %9.1f  max %10.1f ns  (n=%lu)\n", name.c_str(),
+                    static_cast<double>(h.percentile(0.50)), static_cast<double>(h.percentile(0.99)),
+                    static_cast<double>(h.percentile(0.999)), static_cast<double>(h.max()),
+                    static_cast<unsigned long>(h.count()));
+        ok = ok && h.count() == EVENTS;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench_common.hpp"
+#include "symbol_table.hpp"
+#include "work_stealing.hpp"
+
+// Strategy pass over a burst of 32k symbols in 64-row shards (512 tasks), as after a bulk
+// quote response: inline on one thread versus the work-stealing pool with shard affinity,
+// and with every shard keyed to worker 0 so the others have to steal. Reports burst time,
+// task latency (submit -> start) and steal counts. HFT_WAIT_MODE and HFT_WORKER_CPU apply
+// as in the market maker; with fewer cores than workers the pool can only lose.
+
+static constexpr size_t SYMBOLS = 32 * 1024;
+static constexpr size_t SHARD = 64;
+static constexpr size_t BURSTS = 500;
+
+struct Shard : Job {
+    Shard() : Job([](Job* j) {
+        Shard* s = static_cast<Shard*>(j);
+        s->table->computeQuotes(s->begin, s->end);
+    }) {}
+    SymbolStateTable* table = nullptr;
+    size_t begin = 0;
+    size_t end = 0;
+};
+
+static void touchPrices(SymbolStateTable& table, std::mt19937_64& rng) {
+    for(size_t i = 0; i < table.size(); ++i) table.last[i] = 50'000 + static_cast<int64_t>(rng() % 5'000'000);
+}
+
+static void report(const char* name, std::vector<uint64_t>& burst_ticks, WorkStealingPool* pool) {
+    reportLatency(name, burst_ticks);
+    if(!pool) return;
+    uint64_t executed = 0;
+    uint64_t stolen = 0;
+    LatencyHistogram latency;
+    for(size_t i = 0; i < pool->workers(); ++i) {
+        executed += pool->workerStats(i).executed;
+        stolen += pool->workerStats(i).stolen;
+        latency.merge(pool->workerStats(i).latency);
+    }
+    latency.merge(pool->callerStats().latency);
+    std::printf("  %-28s tasks: %lu by workers (%lu stolen), %lu by the submitter; latency p50 %.1f p99 %.1f us\n", "",
+                static_cast<unsigned long>(executed), static_cast<unsigned long>(stolen),
+                static_cast<unsigned long>(pool->callerStats().executed), latency.percentile(0.50) / 1000.0,
+                latency.percentile(0.99) / 1000.0);
+    pool->resetStats();
+}
+
+int main() {
+    ExecutionConfig cfg = ExecutionConfig::fromEnv();
+    size_t workers = std::clamp<size_t>(std::thread::hardware_concurrency(), 2, 8) - 1;
+    std::mt19937_64 rng(42);
+    SymbolStateTable table(SYMBOLS);
+    for(size_t i = 0; i < SYMBOLS; ++i) table.add(std::string("S").append(std::to_string(i)), SpreadBps::fromBps(5.0), 100);
+
+    std::vector<Shard> shards(SYMBOLS / SHARD);
+    for(size_t i = 0; i < shards.size(); ++i) {
+        shards[i].table = &table;
+        shards[i].begin = i * SHARD;
+        shards[i].end = (i + 1) * SHARD;
+    }
+
+    std::printf("Strategy burst: %zu symbols, %zu shards, %zu workers (%u hw threads, %s)\n", SYMBOLS, shards.size(),
+                workers, std::thread::hardware_concurrency(), toString(cfg.mode));
+    std::vector<uint64_t> ticks;
+    ticks.reserve(BURSTS);
+
+    for(size_t b = 0; b < BURSTS; ++b) {
+        touchPrices(table, rng);
+        uint64_t t0 = __rdtsc();
+        for(Shard& s : shards) s.run(&s);
+        ticks.push_back(__rdtsc() - t0);
+    }
+    report("inline, one thread", ticks, nullptr);
+
+    std::vector<int> cpus;
+    for(size_t i = 0; cfg.worker_cpu >= 0 && i < workers; ++i) cpus.push_back(cfg.worker_cpu + static_cast<int>(i));
+    WorkStealingPool pool(workers, cfg.mode, cpus);
+
+    for(int skewed = 0; skewed < 2; ++skewed) {
+        ticks.clear();
+        for(size_t b = 0; b < BURSTS; ++b) {
+            touchPrices(table, rng);
+            uint64_t t0 = __rdtsc();
+            for(size_t i = 0; i < shards.size(); ++i) pool.submit(shards[i], skewed ? 0 : i);
+            pool.wait();
+            ticks.push_back(__rdtsc() - t0);
+        }
+        report(skewed ? "pool, all keyed to worker 0" : "pool, keyed by shard", ticks, &pool);
+    }
+
+    // Same prices through the pool and inline must give the same quotes
+    table.computeQuotes();
+    uint64_t checksum = 0;
+    for(size_t i = 0; i < SYMBOLS; ++i) checksum += static_cast<uint64_t>(table.our_bid[i]);
+    for(size_t i = 0; i < shards.size(); ++i) pool.submit(shards[i], i);
+    pool.wait();
+    uint64_t checksum_pool = 0;
+    for(size_t i = 0; i < SYMBOLS; ++i) checksum_pool += static_cast<uint64_t>(table.our_bid[i]);
+    return checksum == checksum_pool && checksum != 0 ? 0 : 1;
+}
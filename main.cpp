@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <thread>
@@ -5,8 +6,42 @@
 #include <chrono>
 #include <curl/curl.h>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
 #include <iomanip>
 #include <sstream>
+#include <memory>
+#include <memory_resource>
+#include <unordered_map>
+#include <vector>
+
+#include "alloc_counter.hpp"
+#include "async_io.hpp"
+#include "console.hpp"
+#include "csv_decoder.hpp"
+#include "cycle_arena.hpp"
+#include "decimal.hpp"
+#include "fixed_point.hpp"
+#include "execution.hpp"
+#include "http_multi.hpp"
+#include "json_backend.hpp"
+#include "latency_histogram.hpp"
+#include "market_bus.hpp"
+#include "market_tick.hpp"
+#include "numa.hpp"
+#include "order_gateway.hpp"
+#include "orders.hpp"
+#include "page_memory.hpp"
+#include "reactor.hpp"
+#include "spsc_ring.hpp"
+#include "state_file.hpp"
+#include "static_config.hpp"
+#include "quote_snapshot.hpp"
+#include "symbol_table.hpp"
+#include "stream_decoder.hpp"
+#include "task.hpp"
+#include "work_stealing.hpp"
 
 // Simple HFT Market Maker for US Stocks (Alpha Vantage)
 // Strategy: Quote bid/ask around midpoint, capture spread
@@ -14,7 +49,7 @@
 class Portfolio {
     public:
         std::string name = "Iman";
-        std::atomic<double> cash{1'000'000};
+        std::atomic<Money> cash{Money::dollars(1'000'000)};
         std::atomic<int> shares{0};
 };
 
@@ -22,128 +57,513 @@ class MarketMaker {
 private:
     std::string symbol;  // Apple stock
     std::string api_key; // Use "demo" for testing, get free key from alphavantage.co
-    std::atomic<double> last_price{0.0};
-    std::atomic<double> bid_price{0.0};
-    std::atomic<double> ask_price{0.0};
+    Seqlock<QuoteSnapshot> market;  // last/bid/ask of the primary symbol, published together
     std::atomic<bool> running{true};
     
     // Strategy parameters
-    double spread_bps = 5.0;   // 5 basis points spread (0.05%)
-    int share_size = 100;      // Number of shares per order
+#ifdef HFT_STATIC_CONFIG
+    SpreadBps spread_bps = StrategyConfig::SPREAD;
+    int share_size = StrategyConfig::ORDER_SIZE;
+    TickSize tick_size = StrategyConfig::TICK;
+#else
+    SpreadBps spread_bps = SpreadBps::fromBps(5.0);  // 5 basis points spread (0.05%)
+    int share_size = 100;                            // Number of shares per order
+    TickSize tick_size{0};                           // 0 = default tick rule
+#endif
     
     // Alpha Vantage API
     const std::string BASE_URL = "https://www.alphavantage.co/query";
+    std::string quote_url;
+    std::string bulk_url;
+    std::string bulk_csv_url;
+    std::unique_ptr<JsonBackend> json = makeJsonBackend(defaultJsonBackend());
+    
+    // Multi-symbol mode: setSymbol("AAPL,MSFT,NVDA") polls REALTIME_BULK_QUOTES instead of
+    // GLOBAL_QUOTE. The first symbol drives the displayed order book.
+    std::vector<std::string> watchlist;
+    SymbolStateTable symbols;                              // per-symbol state, one row per watchlist entry
+    SymbolId primary = INVALID_SYMBOL;                     // watchlist.front()
+    long first_quote_us = -1;                              // feed thread: request start to first decoded quote
+    bool bulk_csv = !std::getenv("HFT_DATATYPE") || std::string(std::getenv("HFT_DATATYPE")) != "json";
+    
+    // Transient allocations of one poll/parse/quote pass come from the arena, which is
+    // rewound at the end of every cycle. The bulk decoders live across cycles and reuse
+    // their buffers, so a steady-state cycle makes no heap allocations.
+    CycleArena arena{64 * 1024};
+    CsvDecoder bulk_csv_decoder{CsvDecoder::Layout::BulkQuotes};
+    StreamingJsonDecoder bulk_json_decoder{[this](const QuoteRecord& rec) { onBulkQuote(rec); }};
+    std::chrono::steady_clock::time_point bulk_start;
+    bool primary_seen = false;
+    PaperExchange exchange;                                // pooled paper orders, sized in setSymbol
+    StateFile state;                                       // checkpointed every cycle, see restoreState
+    Seqlock<RequestBudget> budget;                         // written by the feed thread
+    
+    // Pipeline: the feed thread (feedLoop) polls and decodes, publishing MarketTicks into
+    // feed_ring; the strategy thread (run) owns the table, orders and portfolio.
+    struct FeedStats {
+        int64_t poll_us = 0;                               // request start to last record decoded
+        long first_quote_us = -1;
+        uint64_t allocs = 0;                               // heap allocations during the poll
+        PageFaults faults;                                 // page faults during the poll
+        uint64_t arena_used = 0;
+        uint64_t arena_spilled = 0;
+    };
+    SpscRing<MarketTick> feed_ring{defaultRingCapacity(), defaultOverflowPolicy()};
+    Seqlock<FeedStats> feed_stats;                         // last poll, published before its marker
+    int64_t poll_start_ns = 0;                             // feed thread: current poll's request time
+    HopLatency feed_hop;                                   // request -> decoded and pushed
+    HopLatency ring_hop;                                   // pushed -> popped by the strategy
+    HopLatency strategy_hop;                               // PollDone popped -> requoted
+    ExecutionConfig exec = ExecutionConfig::fromEnv();     // wait mode, pinning, RT priority
+    LatencyHistogram wake_latency;                         // tick pushed -> handled, since start
+    
+    // The strategy thread parks on strategy_bell while the ring is empty (sleep mode, and
+    // hybrid after its spin window). Every push into feed_ring, every strategy command and
+    // stop() ring it, so none of them waits on a poll interval.
+    enum StrategyCommand : uint32_t { CMD_SET_SPREAD = 1 };
+    Doorbell strategy_bell;
+    std::atomic<uint32_t> strategy_commands{0};
+    std::atomic<int64_t> requested_spread{0};              // centi-bps, for CMD_SET_SPREAD
+    std::atomic<int64_t> command_ns{0};                    // when the latest command was posted
+    
+    // Strategy workers (exec.strategy_workers > 0), started by run. 64 rows of each column
+    // are 8 cache lines, so shards never share a line.
+    static constexpr size_t QUOTE_SHARD = 64;
+    struct QuoteShard : Job {
+        QuoteShard() : Job([](Job* j) {
+            QuoteShard* s = static_cast<QuoteShard*>(j);
+            s->owner->computeQuoteRange(s->begin, s->end);
+        }) {}
+        MarketMaker* owner = nullptr;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+    std::unique_ptr<WorkStealingPool> workers;
+    std::vector<QuoteShard> quote_shards;
+    
+    // The feed thread is a reactor: the timer wheel, the control mailbox and curl's sockets
+    // are all fds on one epoll set, so a command or stop() is handled as soon as it arrives
+    // instead of after the current sleep. The poll cycle itself is a coroutine (pollLoop).
+    enum Command : uint32_t { CMD_POLL_NOW = 1 };
+    Reactor reactor;
+    AsyncTimers timers{reactor};                           // the poll alarm and curl's timeouts
+    HttpMulti http{reactor, timers};
+    HttpRequest poll_request;                              // reused across cycles (keeps the connection alive)
+    Alarm next_poll{timers};                               // pollLoop sleeps on it; CMD_POLL_NOW fires it
+    EventFd control;
+    std::atomic<uint32_t> pending_commands{0};             // Command bits, signalled through control
+    std::pmr::string quote_body{&arena};                   // GLOBAL_QUOTE body of the poll in flight
+    Task poll_loop;
+    
+    // Shared-memory market data bus (market_bus.hpp). A publisher forwards every tick the
+    // feed pushes to other processes; a subscriber takes its feed from the bus (busFeedLoop)
+    // instead of polling the API itself.
+    BusConfig bus = BusConfig::fromEnv();
+    MarketBusPublisher bus_out;                            // feed thread, opened in run
+    MarketBusSubscriber bus_in;                            // feed thread, once the bus exists
+    std::atomic<bool> bus_attached{false};                 // bus_in is open; other threads may use it
+    static constexpr auto BUS_RETRY = std::chrono::milliseconds(100);  // until the publisher creates the bus
+    
+    // Order gateway (order_gateway.hpp), opted into with HFT_ORDER_GATEWAY=name: every paper
+    // order and cancel also goes to the execution process serving /dev/shm/name, sent from
+    // PaperExchange as it is placed (GatewayRouter). The paper book still decides fills and
+    // the portfolio; the gateway's answers are counted in the order report. Strategy thread
+    // only.
+    struct GatewayCounts {
+        uint64_t sent = 0;
+        uint64_t refused = 0;                              // not sent: ring full, or the gateway restarting
+        uint64_t acks = 0;
+        uint64_t rejects = 0;
+        uint64_t cancelled = 0;
+        uint64_t fills = 0;
+    };
+    struct GatewayRouter : OrderRouter {
+        MarketMaker* owner = nullptr;
+        bool route(EventKind kind, const Order& o) override { return owner->sendOrder(kind, o); }
+    };
+    std::string gateway_name;
+    OrderGatewayClient gateway;
+    GatewayRouter gateway_router;
+    GatewayCounts gateway_counts;
+    
+    static size_t WriteCallback(char* contents, size_t size, size_t nmemb, void* userp) {
+        ((std::pmr::string*)userp)->append(contents, size * nmemb);
+        return size * nmemb;
+    }
     
-    static size_t WriteCallback(void* contents, size_t size, size_t nmemb, void* userp) {
-        ((std::string*)userp)->append((char*)contents, size * nmemb);
+    // Feeds body chunks to a streaming decoder (JSON or CSV) as they arrive
+    template<class Decoder>
+    static size_t StreamCallback(char* contents, size_t size, size_t nmemb, void* userp) {
+        static_cast<Decoder*>(userp)->feed(contents, size * nmemb);
         return size * nmemb;
     }
     
-    std::string httpGet(const std::string& url) {
-        CURL* curl = curl_easy_init();
-        std::string response;
+    
+    void applyQuote(SymbolId id, const QuoteRecord& quote) {
+        if(id == INVALID_SYMBOL) return;
+        int64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        symbols.applyQuote(id, quote, now_ns);
+        if(quote.has(QuoteField::Price)) exchange.onTick(id, Price{quote.price}, now_ns);
+        if(id != primary) return;
         
-        if(curl) {
-            std::cout << "Is curl here?" << std::endl;
-            curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-            curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
-            curl_easy_setopt(curl, CURLOPT_TIMEOUT, 10L);
-            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
-            
-            CURLcode res = curl_easy_perform(curl);
-            curl_easy_cleanup(curl);
+        QuoteSnapshot snap = market.load();
+        snap.last = Price{quote.price};
+        if(quote.has(QuoteField::Low)) {
+            snap.bid = Price{quote.low};
+        }
+        if(quote.has(QuoteField::High)) {
+            snap.ask = Price{quote.high};
+        }
+        if(quote.has(QuoteField::Volume)) {
+            snap.volume = quote.volume;
+        }
+        snap.updated_ns = now_ns;
+        market.store(snap);
+    }
+    
+    // Request URLs only change with the symbol list or key, so they are built once here
+    // rather than concatenated every cycle.
+    void buildUrls() {
+        quote_url = BASE_URL + "?function=GLOBAL_QUOTE&symbol=" + symbol + "&apikey=" + api_key;
+        bulk_url = BASE_URL + "?function=REALTIME_BULK_QUOTES&symbol=" + symbol + "&apikey=" + api_key;
+        bulk_csv_url = bulk_url + "&datatype=csv";
+    }
+    
+    // Strategy pass over the table. With HFT_STRATEGY_WORKERS set, a large table is cut
+    // into QUOTE_SHARD-row shards that run on the work-stealing pool; shard i always goes
+    // to the same worker first (shardOwner).
+    void computeQuotes() {
+        size_t n = symbols.size();
+        if(!workers || n <= QUOTE_SHARD) {
+            computeQuoteRange(0, n);
+            return;
+        }
+        size_t shards = (n + QUOTE_SHARD - 1) / QUOTE_SHARD;
+        if(quote_shards.size() != shards) {
+            quote_shards.assign(shards, QuoteShard{});
+            for(size_t i = 0; i < shards; ++i) {
+                quote_shards[i].owner = this;
+                quote_shards[i].begin = i * QUOTE_SHARD;
+                quote_shards[i].end = std::min(n, (i + 1) * QUOTE_SHARD);
+            }
+        }
+        for(size_t i = 0; i < shards; ++i) workers->submit(quote_shards[i], shardOwner(i, shards));
+        workers->wait();
+    }
+    
+    // Workers own contiguous blocks of shards, so each worker's rows are one run of pages
+    // that placeMemory can put on its node.
+    size_t shardOwner(size_t shard, size_t shards) const {
+        return shard * static_cast<size_t>(exec.strategy_workers) / shards;
+    }
+    
+    // Specialized on the compiled-in config in static builds.
+    void computeQuoteRange(size_t begin, size_t end) {
+#ifdef HFT_STATIC_CONFIG
+        computeQuotesStatic<StrategyConfig>(symbols, begin, end);
+#else
+        symbols.computeQuotes(begin, end);
+#endif
+    }
+    
+    static int64_t steadyNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    
+    // Feed side: hands a decoded quote to the strategy thread.
+    void publishQuote(SymbolId id, const QuoteRecord& rec) {
+        if(id == INVALID_SYMBOL) return;
+        publish(MarketTick::quote(id, rec, poll_start_ns, steadyNs()), feed_ring.policy());
+    }
+    
+    // Feed side: pushes a tick and wakes the strategy thread if it is parked; forwards it
+    // to the market data bus when publishing there.
+    void publish(const MarketTick& tick, OverflowPolicy policy) {
+        feed_ring.push(tick, policy);
+        strategy_bell.ring();
+        if(!bus_out.isOpen()) return;
+        BusTick out;
+        out.kind = tick.kind;
+        out.present = tick.present;
+        if(tick.kind == MarketTick::Kind::Quote) out.symbol = symbols.symbols().key(tick.symbol);
+        out.last = tick.last;
+        out.low = tick.low;
+        out.high = tick.high;
+        out.volume = tick.volume;
+        out.stamp_ns = tick.request_ns;
+        bus_out.publish(out);
+    }
+    
+    static int64_t unixMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+    
+    void noteRequest() {
+        std::time_t now = std::time(nullptr);
+        std::tm utc{};
+        gmtime_r(&now, &utc);
+        int32_t day = (utc.tm_year + 1900) * 10000 + (utc.tm_mon + 1) * 100 + utc.tm_mday;
+        RequestBudget b = budget.load();
+        if(day != b.day) {
+            b.day = day;
+            b.requests_today = 0;
+        }
+        ++b.requests_today;
+        b.last_request_unix_ms = unixMs();
+        budget.store(b);
+    }
+    
+    void saveState(Portfolio* portfolio) {
+        state.checkpoint([&](StateSlot& slot) {
+            slot.saved_unix_ms = unixMs();
+            slot.cash = portfolio->cash.load();
+            slot.shares = portfolio->shares.load();
+            slot.budget = bus.subscribe.empty() ? budget.load() : RequestBudget{};  // subscribers send no requests
+            // A watchlist past the file's capacity keeps only its first symbols (restoreState warns)
+            uint32_t n = static_cast<uint32_t>(std::min<size_t>(symbols.size(), STATE_SYMBOL_CAPACITY));
+            for(SymbolId id = 0; id < n; ++id) {
+                PersistedSymbol& ps = slot.symbols[id];
+                ::setSymbol(ps.symbol, symbols.name(id));
+                ps.last = symbols.last[id];
+                ps.bid = symbols.bid[id];
+                ps.ask = symbols.ask[id];
+                ps.volume = symbols.volume[id];
+                ps.position = symbols.position[id];
+            }
+            slot.symbol_count = n;
+        });
+    }
+    
+    TickSize primaryTickSize(Price mid) const {
+        return primary != INVALID_SYMBOL ? symbols.tickSize(primary) : defaultTickSize(mid);
+    }
+    
+    // Bulk quotes are decoded while the body downloads; each symbol is published as soon
+    // as its record is complete. datatype=csv (the default) is about a quarter of the JSON
+    // size; HFT_DATATYPE=json selects the JSON stream instead.
+    void onBulkQuote(const QuoteRecord& rec) {
+        if(first_quote_us < 0) {
+            first_quote_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - bulk_start).count();
+        }
+        if(!rec.has(QuoteField::Price)) return;
+        SymbolId id = symbols.find(rec.symbolView());
+        publishQuote(id, rec);
+        primary_seen = primary_seen || id == primary;
+    }
+    
+    bool finishBulkPoll() {
+        size_t records = 0;
+        const std::string* head = nullptr;
+        if(bulk_csv) {
+            bulk_csv_decoder.finish();
+            records = bulk_csv_decoder.rowCount();
+            head = &bulk_csv_decoder.bodyHead();
+        } else {
+            records = bulk_json_decoder.recordCount();
+            head = &bulk_json_decoder.bodyHead();
+        }
+        
+        if(records == 0) {
+            std::cerr << "API Error/Note: " << *head << std::endl;
+            return false;
+        }
+        return primary_seen;
+    }
+    
+    // The feed's poll cycle, one coroutine on the reactor: request, decode, publish, then
+    // sleep until the next poll is due or a poll-now command cuts the sleep short.
+    Task pollLoop(std::chrono::milliseconds first_delay) {
+        co_await next_poll.until(std::chrono::steady_clock::now() + first_delay);
+        while(!reactor.stopped()) {
+            poll_start_ns = steadyNs();
+            uint64_t allocs_before = heapAllocations();
+            PageFaults faults_before = PageFaults::thisThread();
             
+            CURLcode res = co_await fetchPoll();
+            bool success = false;
             if(res != CURLE_OK) {
                 std::cerr << "HTTP Error: " << curl_easy_strerror(res) << std::endl;
-                return "";
+            } else {
+                success = watchlist.size() > 1 ? finishBulkPoll() : finishQuotePoll();
             }
+            
+            FeedStats stats;
+            stats.poll_us = (steadyNs() - poll_start_ns) / 1000;
+            stats.first_quote_us = first_quote_us;
+            stats.allocs = heapAllocations() - allocs_before;
+            stats.faults = PageFaults::thisThread() - faults_before;
+            stats.arena_used = arena.used();
+            stats.arena_spilled = arena.overflows();
+            feed_stats.store(stats);
+            std::pmr::string(&arena).swap(quote_body);     // let go of the body before the rewind
+            arena.reset();
+            
+            MarketTick::Kind kind = success ? MarketTick::Kind::PollDone : MarketTick::Kind::PollFailed;
+            publish(MarketTick::marker(kind, poll_start_ns, steadyNs()), OverflowPolicy::Block);
+            
+            // Alpha Vantage free tier: 5 calls/minute, wait 12+ seconds
+            int wait_time = !success ? 5 : (api_key == "demo") ? 15 : 12;
+            co_await next_poll.until(std::chrono::steady_clock::now() + std::chrono::seconds(wait_time));
+        }
+    }
+    
+    // Resets the decoders for the next body and starts its request. The GLOBAL_QUOTE body
+    // is allocated from the cycle arena.
+    FetchAwaiter fetchPoll() {
+        std::cout << "Is curl here?" << std::endl;
+        noteRequest();
+        if(watchlist.size() <= 1) {
+            return fetch(http, poll_request, quote_url, WriteCallback, &quote_body);
+        }
+        bulk_start = std::chrono::steady_clock::now();
+        primary_seen = false;
+        first_quote_us = -1;
+        if(bulk_csv) {
+            bulk_csv_decoder.reset();
+            return fetch(http, poll_request, bulk_csv_url, StreamCallback<CsvDecoder>, &bulk_csv_decoder);
+        }
+        bulk_json_decoder.reset();
+        return fetch(http, poll_request, bulk_url, StreamCallback<StreamingJsonDecoder>, &bulk_json_decoder);
+    }
+    
+    // Runs on the reactor when control is signalled.
+    void runCommands() {
+        uint32_t cmds = pending_commands.exchange(0);
+        if(cmds & CMD_POLL_NOW) {
+            // A poll in flight already counts; otherwise this wakes pollLoop early
+            next_poll.fire();
         }
-        return response;
     }
     
-    bool updateMarketPrice() {
-        // Get real-time quote
-        std::string url = BASE_URL + "?function=GLOBAL_QUOTE&symbol=" + symbol + "&apikey=" + api_key;
-        std::string response = httpGet(url);
+    bool finishQuotePoll() {
+        const std::pmr::string& response = quote_body;
         
         if(response.empty()) {
             return false;
         }
         
-        // Quick, dependency-free extraction of quoted JSON values:
-        auto extractQuotedValue = [&](const std::string& key) -> std::string {
-            std::string quotedKey = "\"" + key + "\"";
-            size_t keyPos = response.find(quotedKey);
-            if(keyPos == std::string::npos) return "";
-            size_t colonPos = response.find(':', keyPos + quotedKey.size());
-            if(colonPos == std::string::npos) return "";
-            // find first quote after colon
-            size_t firstQuote = response.find('"', colonPos);
-            if(firstQuote == std::string::npos) return "";
-            size_t secondQuote = response.find('"', firstQuote + 1);
-            if(secondQuote == std::string::npos) return "";
-            return response.substr(firstQuote + 1, secondQuote - firstQuote - 1);
-        };
-        
-        // Alpha Vantage returns "Global Quote": { "05. price": "123.45", ... }
-        std::string priceStr = extractQuotedValue("05. price");
-        if(priceStr.empty()) {
+        QuoteRecord quote;
+        if(!json->parseGlobalQuote(response, quote)) {
             // response may contain an error or different format
             // attempt to detect API-level errors to log
             if(response.find("Error Message") != std::string::npos || response.find("Note") != std::string::npos) {
                 std::cerr << "API Error/Note: " << response << std::endl;
+            } else if(json->priceUnparsed()) {
+                std::cerr << "Failed to parse price: " << json->unparsedPrice() << std::endl;
             } else {
                 std::cerr << "Unexpected response (missing 05. price): " << response << std::endl;
             }
             return false;
         }
         
-        try {
-            double price = std::stod(priceStr);
-            last_price = price;
-        } catch(...) {
-            std::cerr << "Failed to parse price: " << priceStr << std::endl;
-            return false;
-        }
-        
-        std::string lowStr = extractQuotedValue("04. low");
-        if(!lowStr.empty()) {
-            try { bid_price = std::stod(lowStr); } catch(...) {}
-        }
-        std::string highStr = extractQuotedValue("03. high");
-        if(!highStr.empty()) {
-            try { ask_price = std::stod(highStr); } catch(...) {}
-        }
-        
+        publishQuote(primary, quote);
         return true;
     }
     
     void displayOrderBook() {
-        double mid = last_price.load();
-        if(mid <= 0) return;
+        QuoteSnapshot snap = market.load();
+        Price mid = snap.last;
+        if(!mid.positive()) return;
         
-        double spread_factor = spread_bps / 10000.0;
-        double our_bid = mid * (1.0 - spread_factor);
-        double our_ask = mid * (1.0 + spread_factor);
+        QuotePair ours = quoteAround(mid, spread_bps, primaryTickSize(mid));
+        Price our_bid = ours.bid;
+        Price our_ask = ours.ask;
         
         std::cout << "\n=== SIMULATED ORDER BOOK ===" << std::endl;
-        std::cout << "Market ASK:  $" << std::fixed << std::setprecision(2) << ask_price.load() << std::endl;
+        std::cout << "Market ASK:  $" << std::fixed << std::setprecision(2) << snap.ask << std::endl;
         std::cout << "Our ASK:     $" << our_ask << " [" << share_size << " shares]  <-- SELL" << std::endl;
         std::cout << "------------ MID: $" << mid << " ------------" << std::endl;
         std::cout << "Our BID:     $" << our_bid << " [" << share_size << " shares]  <-- BUY" << std::endl;
-        std::cout << "Market BID:  $" << std::fixed << std::setprecision(2) << bid_price.load() << std::endl;
+        std::cout << "Market BID:  $" << std::fixed << std::setprecision(2) << snap.bid << std::endl;
+    }
+    
+    // Paper fills move cash and the symbol's position; Portfolio::shares tracks the primary.
+    void applyFill(Portfolio* portfolio, const Fill& f) {
+        int64_t signedQty = f.side == Side::Buy ? f.qty : -f.qty;
+        Money cash = portfolio->cash.load();
+        if(f.side == Side::Buy) cash -= notional(f.price, f.qty);
+        else cash += notional(f.price, f.qty);
+        portfolio->cash.store(cash);
+        symbols.position[f.symbol] += signedQty;
+        if(f.symbol == primary) portfolio->shares += static_cast<int>(signedQty);
+    }
+    
+    // Order activity since the last cycle plus pool usage. Placement is simulated; with an
+    // order gateway each order is also sent out as it is placed (sendOrder).
+    void displayOrders() {
+        int placed = 0, cancelled = 0, filled = 0;
+        uint64_t dropped = exchange.drainEvents([&](const Event& e) {
+            if(e.kind == EventKind::OrderNew) ++placed;
+            else if(e.kind == EventKind::OrderCancel) ++cancelled;
+            else {
+                ++filled;
+                std::cout << "   FILL " << (e.side == Side::Buy ? "BUY  " : "SELL ") << e.qty << " "
+                          << symbols.name(e.symbol) << " @ $" << std::setprecision(2) << e.price << std::endl;
+            }
+        });
+        std::cout << "\n📝 Paper orders: " << placed << " placed, " << cancelled << " cancelled, "
+                  << filled << " filled" << std::endl;
+        if(dropped) {
+            std::cout << "   ⚠️  " << dropped << " more not listed: event pool full (raise HFT_POOL_EVENTS)" << std::endl;
+        }
+        std::cout << "   Pools:  orders " << exchange.orderStats() << ", fills " << exchange.fillStats() << std::endl;
+        std::cout << "           ticks " << exchange.tickStats() << ", events " << exchange.eventStats() << std::endl;
+        if(!gateway.isOpen()) return;
+        collectGatewayResponses();
+        const GatewayCounts& g = gateway_counts;
+        std::cout << "   Gateway: " << gateway_name << ", " << g.sent << " sent, " << g.refused << " refused; "
+                  << g.acks << " acked, " << g.rejects << " rejected, " << g.cancelled << " cancelled, " << g.fills
+                  << " filled";
+        if(gateway.reconnects()) std::cout << ", reconnected " << gateway.reconnects() << " time(s)";
+        std::cout << std::endl;
+    }
+    
+    // Strategy thread, from PaperExchange: sends one order or cancel through the gateway.
+    // Paper fills stay local.
+    bool sendOrder(EventKind kind, const Order& o) {
+        OrderRequest r;
+        r.kind = kind == EventKind::OrderNew ? OrderRequestKind::New : OrderRequestKind::Cancel;
+        r.side = o.side;
+        SymbolKey::pack(symbols.name(o.symbol), r.symbol);
+        r.client_order_id = o.id;
+        r.price = o.price;
+        r.qty = o.qty;
+        r.sent_ns = steadyNs();
+        if(!gateway.send(r)) {
+            ++gateway_counts.refused;
+            return false;
+        }
+        ++gateway_counts.sent;
+        return true;
+    }
+    
+    // Strategy thread: picks up the gateway's answers so far.
+    void collectGatewayResponses() {
+        if(!gateway.isOpen()) return;
+        OrderResponse r;
+        while(gateway.receive(r)) {
+            switch(r.kind) {
+                case OrderResponseKind::Ack: ++gateway_counts.acks; break;
+                case OrderResponseKind::Reject: ++gateway_counts.rejects; break;
+                case OrderResponseKind::Cancelled: ++gateway_counts.cancelled; break;
+                case OrderResponseKind::Fill: ++gateway_counts.fills; break;
+            }
+        }
     }
     
-    void displayStats(int cycle, long latency_us) {
-        double mid = last_price.load();
-        if(mid <= 0) return;
+    void displayStats(int cycle, long latency_us, long first_quote_us) {
+        Price mid = market.load().last;
+        if(!mid.positive()) return;
         
-        double spread_factor = spread_bps / 10000.0;
-        double our_bid = mid * (1.0 - spread_factor);
-        double our_ask = mid * (1.0 + spread_factor);
-        double spread_dollars = our_ask - our_bid;
-        double profit_per_rt = spread_dollars * share_size;
+        QuotePair ours = quoteAround(mid, spread_bps, primaryTickSize(mid));
+        Price our_bid = ours.bid;
+        Price our_ask = ours.ask;
+        Price spread_dollars = our_ask - our_bid;
+        Money profit_per_rt = notional(spread_dollars, share_size);
         
         auto now = std::chrono::system_clock::now();
         auto time = std::chrono::system_clock::to_time_t(now);
@@ -161,16 +581,376 @@ private:
         std::cout << "Profit/RT:   $" << std::setprecision(2) << profit_per_rt 
                   << " per round trip" << std::endl;
         std::cout << "Latency:     " << latency_us << " μs" << std::endl;
+        if(watchlist.size() > 1) {
+            std::cout << "First quote: " << first_quote_us << " μs (streamed)" << std::endl;
+            std::cout << "Watchlist:" << std::endl;
+            for(SymbolId id = 0; id < symbols.size(); ++id) {
+                if(!symbols.lastPrice(id).positive()) continue;
+                QuotePair q = symbols.ourQuote(id);
+                std::cout << "  " << std::left << std::setw(8) << symbols.name(id) << std::right << " $"
+                          << std::setprecision(2) << symbols.lastPrice(id)
+                          << "  bid $" << q.bid << " / ask $" << q.ask << std::endl;
+            }
+        }
         std::cout << "========================================" << std::endl;
     }
     
 public:
+    MarketMaker() {
+        bulk_csv_decoder.setQuoteSink([this](const QuoteRecord& rec) { onBulkQuote(rec); });
+        buildUrls();                                       // so a run without arguments still polls
+    }
+    
     std::string getSymbol() { return symbol; }
-    void setSymbol(const std::string& sym) { symbol = sym; }
-    void setApiKey(const std::string& key) { api_key = key; }
-    void setSpread(double bps) { spread_bps = bps; }
-    void setShareSize(int size) { share_size = size; }
+    void setSymbol(const std::string& sym) {
+        symbol = sym;
+        watchlist.clear();
+        std::stringstream ss(sym);
+        for(std::string item; std::getline(ss, item, ',');) {
+            if(!item.empty()) watchlist.push_back(item);
+        }
+        symbols = SymbolStateTable(watchlist.size());
+        for(const std::string& item : watchlist) {
+            symbols.add(item, spread_bps, share_size, tick_size);
+        }
+        primary = watchlist.empty() ? INVALID_SYMBOL : symbols.find(watchlist.front());
+        exchange = PaperExchange(PoolConfig::forSymbols(watchlist.size()), watchlist.size());
+        buildUrls();
+    }
+    void setApiKey(const std::string& key) {
+        api_key = key;
+        buildUrls();
+    }
+    // Maps the state file (HFT_STATE_FILE, default market_maker.state, or
+    // market_maker.<bus>.<consumer>.state for a bus subscriber; empty disables) and resumes
+    // from its last checkpoint: cash, shares, request budget (not a subscriber's, which
+    // sends no requests), and the cached quotes and positions of every symbol still on the
+    // watchlist. Call after setSymbol. A file another process holds is left alone and this
+    // one runs without checkpoints.
+    void restoreState(Portfolio* portfolio) {
+        const char* env = std::getenv("HFT_STATE_FILE");
+        std::string path = env ? env
+                         : bus.subscribe.empty() ? "market_maker.state"
+                         : "market_maker." + bus.subscribe + "." + bus.consumer + ".state";
+        if(path.empty()) return;
+        
+        auto start = std::chrono::steady_clock::now();
+        StateFile::OpenResult result = state.open(path);
+        if(result == StateFile::OpenResult::Failed) {
+            std::cerr << "State file " << path << ": " << std::strerror(state.error()) << std::endl;
+            return;
+        }
+        if(result == StateFile::OpenResult::Locked) {
+            std::cerr << "State file " << path << " is in use by another process; running without checkpoints "
+                      << "(set HFT_STATE_FILE to give this one its own)" << std::endl;
+            return;
+        }
+        if(symbols.size() > STATE_SYMBOL_CAPACITY) {
+            std::cerr << "State file " << path << " holds " << STATE_SYMBOL_CAPACITY << " of the " << symbols.size()
+                      << " watchlist symbols; quotes and positions of the rest are not checkpointed" << std::endl;
+        }
+        const StateSlot* slot = state.latest();
+        size_t restored = 0;
+        if(result == StateFile::OpenResult::Restored && slot->generation > 0) {
+            portfolio->cash.store(slot->cash);
+            portfolio->shares.store(static_cast<int>(slot->shares));
+            if(bus.subscribe.empty()) budget.store(slot->budget);
+            for(uint32_t i = 0; i < slot->symbol_count && i < STATE_SYMBOL_CAPACITY; ++i) {
+                const PersistedSymbol& ps = slot->symbols[i];
+                SymbolId id = symbols.find(ps.symbolView());
+                if(id == INVALID_SYMBOL) continue;
+                symbols.last[id] = ps.last;
+                symbols.bid[id] = ps.bid;
+                symbols.ask[id] = ps.ask;
+                symbols.volume[id] = ps.volume;
+                symbols.position[id] = ps.position;
+                ++restored;
+            }
+            computeQuotes();
+            if(primary != INVALID_SYMBOL) {
+                market.store(QuoteSnapshot{symbols.lastPrice(primary), Price{symbols.bid[primary]},
+                                           Price{symbols.ask[primary]}, symbols.volume[primary], 0});
+            }
+        }
+        long us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "State file " << path << ": " << toString(result);
+        if(restored) {
+            std::cout << ", " << restored << " symbols from a checkpoint "
+                      << (unixMs() - slot->saved_unix_ms) / 1000 << " s old";
+        }
+        std::cout << " (" << us << " μs)" << std::endl;
+    }
+    void setSpread(double bps) { applySpread(SpreadBps::fromBps(bps)); }
+    // Overrides the default tick rule for a watchlist symbol (call after setSymbol)
+    void setTickSize(const std::string& sym, TickSize tick) {
+        SymbolId id = symbols.find(sym);
+        if(id != INVALID_SYMBOL) symbols.tick[id] = tick.ticks;
+    }
+    void setShareSize(int size) {
+        share_size = size;
+        for(SymbolId id = 0; id < symbols.size(); ++id) symbols.order_size[id] = size;
+    }
+    
+    // Feed thread: polls on the rate-limit schedule and publishes each decoded quote, then
+    // a PollDone/PollFailed marker, into feed_ring. Markers always block, so a cycle is
+    // never lost whatever the overflow policy for quotes.
+    void feedLoop() {
+        setupThread("feed", exec.feed_cpu);
+        if(lowJitterRequested()) prefaultStack();
+        reactor.add(control.fd(), EPOLLIN, [this](uint32_t) {
+            control.drain();
+            runCommands();
+        });
+        
+        // After a restart, honour the rate limit from the restored request budget
+        int64_t last_request_ms = budget.load().last_request_unix_ms;
+        int64_t since_last_ms = unixMs() - last_request_ms;
+        int64_t min_gap_ms = (api_key == "demo" ? 15 : 12) * 1000;
+        int64_t first_poll_ms = 0;
+        if(last_request_ms > 0 && since_last_ms >= 0 && since_last_ms < min_gap_ms) {
+            first_poll_ms = min_gap_ms - since_last_ms;
+            std::cout << "Resuming: waiting " << first_poll_ms << " ms for the rate limit" << std::endl;
+        }
+        poll_loop = pollLoop(std::chrono::milliseconds(first_poll_ms));
+        poll_loop.start();
+        
+        reactor.run(exec.mode);
+        
+        // pollLoop is parked in a fetch or a sleep; the fetch must not resume it once it is
+        // gone (a sleep unschedules itself)
+        http.cancel(poll_request);
+        poll_loop = Task();
+        reactor.remove(control.fd());
+    }
+    
+    // Feed thread in subscriber mode: waits for the bus to be created, then turns its ticks
+    // into MarketTicks for our own symbols (others are skipped) and pushes them into
+    // feed_ring. Quotes carry the publisher's poll start as their request time, so the
+    // fetch+decode hop spans both processes. Until the bus exists the reactor waits on a
+    // retry timer, so stop() wakes it at once; after that it parks on the bus futex.
+    void busFeedLoop() {
+        setupThread("feed", exec.feed_cpu);
+        if(lowJitterRequested()) prefaultStack();
+        int err = bus_in.open(bus.subscribe, bus.consumer);
+        if(err) {
+            std::cerr << "Market data bus " << bus.subscribe << ": " << std::strerror(err)
+                      << (err == ENOENT ? ", waiting for the publisher" : "") << std::endl;
+            TimerFd retry;
+            retry.arm(BUS_RETRY, BUS_RETRY);
+            reactor.add(retry.fd(), EPOLLIN, [&](uint32_t) {
+                retry.drain();
+                err = bus_in.open(bus.subscribe, bus.consumer);
+            });
+            while(err && running) reactor.runOnce(-1);
+            reactor.remove(retry.fd());
+        }
+        if(!running) return;
+        bus_attached.store(true, std::memory_order_release);
+        
+        Waiter waiter(exec.mode);
+        auto ready = [this] { return bus_in.available() > 0 || !running; };
+        BusTick in;
+        while(running) {
+            MarketBusSubscriber::Read r = bus_in.poll(in);
+            if(r == MarketBusSubscriber::Read::Empty) {
+                waiter.idle(bus_in, ready);
+                continue;
+            }
+            waiter.reset();
+            if(r == MarketBusSubscriber::Read::Reattached) {
+                std::cerr << "Market data bus " << bus.subscribe << ": recreated by the publisher, re-attached" << std::endl;
+            }
+            if(r != MarketBusSubscriber::Read::Tick) continue;      // overruns are counted; shown in the bus line
+            if(in.kind != MarketTick::Kind::Quote) {
+                publish(MarketTick::marker(in.kind, in.stamp_ns, steadyNs()), OverflowPolicy::Block);
+                continue;
+            }
+            SymbolId id = symbols.symbols().find(in.symbol);
+            if(id == INVALID_SYMBOL) continue;
+            MarketTick t;
+            t.symbol = id;
+            t.present = in.present;
+            t.last = in.last;
+            t.low = in.low;
+            t.high = in.high;
+            t.volume = in.volume;
+            t.request_ns = in.stamp_ns;
+            t.decoded_ns = steadyNs();
+            publish(t, feed_ring.policy());
+        }
+    }
+    
+    // Pins the calling thread and raises it to SCHED_FIFO as configured; reports failures.
+    void setupThread(const char* role, int cpu) {
+        if(cpu >= 0) {
+            int err = pinThisThread(cpu);
+            if(err) std::cerr << "Pin " << role << " thread to CPU " << cpu << ": " << std::strerror(err) << std::endl;
+        }
+        if(exec.rt_priority > 0) {
+            int err = setRealtimePriority(exec.rt_priority);
+            if(err) std::cerr << "SCHED_FIFO for " << role << " thread: " << std::strerror(err) << std::endl;
+        }
+    }
+    
+    void displayPipeline() {
+        RingStats r = feed_ring.stats();
+        std::cout << "   Feed ring:   depth " << r.depth << "/" << r.capacity << " (high " << r.high_water
+                  << "), " << toString(feed_ring.policy()) << ", dropped " << r.dropped
+                  << ", producer waits " << r.producer_waits << std::endl;
+        std::cout << "   Hops (avg/max μs): fetch+decode " << feed_hop.meanUs() << "/" << feed_hop.maxUs()
+                  << ", ring " << ring_hop.meanUs() << "/" << ring_hop.maxUs()
+                  << ", strategy " << strategy_hop.meanUs() << "/" << strategy_hop.maxUs() << std::endl;
+        std::cout << "   Wake->handle (" << toString(exec.mode) << "): p50 " << wake_latency.percentile(0.50) / 1000.0
+                  << ", p99 " << wake_latency.percentile(0.99) / 1000.0 << ", max " << wake_latency.max() / 1000.0
+                  << " μs over " << wake_latency.count() << " ticks" << std::endl;
+        feed_hop.reset();
+        ring_hop.reset();
+        strategy_hop.reset();
+        if(workers) displayWorkers();
+        if(bus_out.isOpen() || bus_attached.load(std::memory_order_acquire)) displayBus();
+    }
     
+    void displayBus() {
+        if(bus_attached.load(std::memory_order_acquire)) {
+            std::cout << "   Bus in:      " << bus.subscribe << ", lag " << bus_in.available() << ", overruns "
+                      << bus_in.overruns() << (bus_in.flaggedSlow() ? ", flagged slow" : "") << std::endl;
+        }
+        if(!bus_out.isOpen()) return;
+        std::vector<BusConsumerInfo> consumers = bus_out.consumers();
+        std::cout << "   Bus out:     " << bus.publish << ", " << consumers.size() << " consumer(s)";
+        for(const BusConsumerInfo& c : consumers) {
+            std::cout << "; " << c.name << " (pid " << c.pid << ") lag " << c.lag << ", overruns " << c.overruns;
+            if(c.slow_events) std::cout << ", slow " << c.slow_events << "x" << (c.slow ? " (now)" : "");
+        }
+        std::cout << std::endl;
+    }
+    
+    void displayWorkers() {
+        uint64_t executed = 0;
+        uint64_t stolen = 0;
+        LatencyHistogram latency;
+        for(size_t i = 0; i < workers->workers(); ++i) {
+            const WorkerStats& w = workers->workerStats(i);
+            executed += w.executed;
+            stolen += w.stolen;
+            latency.merge(w.latency);
+        }
+        const WorkerStats& caller = workers->callerStats();
+        latency.merge(caller.latency);
+        std::cout << "   Workers:     " << workers->workers() << " (" << executed << " shards run by workers, "
+                  << stolen << " stolen, " << caller.executed << " by the strategy thread), task latency p50 "
+                  << latency.percentile(0.50) / 1000.0 << ", p99 " << latency.percentile(0.99) / 1000.0 << ", max "
+                  << latency.max() / 1000.0 << " μs" << std::endl;
+        workers->resetStats();
+    }
+    
+    void applySpread(SpreadBps spread) {
+        spread_bps = spread;
+        for(SymbolId id = 0; id < symbols.size(); ++id) symbols.spread[id] = spread_bps.centi_bps;
+    }
+    
+    // Strategy thread: applies the commands posted since the last call.
+    void runStrategyCommands() {
+        uint32_t cmds = strategy_commands.exchange(0, std::memory_order_acquire);
+        if(cmds & CMD_SET_SPREAD) {
+#ifdef HFT_STATIC_CONFIG
+            std::cout << "\nSpread is compiled in (" << spread_bps << " bps); rebuild to change it" << std::endl;
+#else
+            applySpread(SpreadBps{requested_spread.load(std::memory_order_relaxed)});
+            computeQuotes();
+            exchange.requote(symbols, steadyNs());
+            collectGatewayResponses();
+            long us = static_cast<long>((steadyNs() - command_ns.load(std::memory_order_relaxed)) / 1000);
+            std::cout << "\nSpread now " << spread_bps << " bps, requoted " << symbols.size() << " symbols "
+                      << us << " μs after the request" << std::endl;
+#endif
+        }
+    }
+    
+    // Opens the publishing side of the bus, if configured, before the feed thread starts.
+    void openBus() {
+        if(bus.publish.empty()) return;
+        if(bus.publish == bus.subscribe) {
+            std::cerr << "Market data bus " << bus.publish << ": cannot publish to the bus we subscribe to" << std::endl;
+            return;
+        }
+        int err = bus_out.open(bus.publish, bus.capacity);
+        if(err) {
+            std::cerr << "Market data bus " << bus.publish << ": " << std::strerror(err) << std::endl;
+            return;
+        }
+        std::cout << "  Bus out:    /dev/shm/" << bus.publish << " (" << bus_out.capacity() << " slots)" << std::endl;
+    }
+    
+    // Claims a channel on the order gateway, if configured; without one orders stay on paper.
+    void openGateway() {
+        const char* name = std::getenv("HFT_ORDER_GATEWAY");
+        if(!name || !*name) return;
+        gateway_name = name;
+        int err = gateway.open(gateway_name, "market_maker");
+        if(err) {
+            std::cerr << "Order gateway " << gateway_name << ": " << std::strerror(err) << "; orders stay on paper"
+                      << std::endl;
+            return;
+        }
+        gateway_router.owner = this;
+        exchange.setRouter(&gateway_router);
+        std::cout << "  Gateway:    /dev/shm/" << gateway_name << ", channel " << gateway.channelIndex() << std::endl;
+    }
+    
+    // Moves each structure to the NUMA node of the thread that owns it: the table, order
+    // pools and feed ring (the strategy thread polls it) to the strategy thread's node, the
+    // cycle arena to the feed thread's and, with pinned strategy workers, each worker's
+    // block of shards to the worker's node. Unpinned threads count as being on the strategy
+    // thread's node. Runs on the strategy thread before the feed thread starts.
+    void placeMemory() {
+        NumaTopology topo = NumaTopology::discover();
+        if(!topo.numa() || !exec.numa_placement) {
+            std::cout << "  NUMA:       " << topo.size() << (topo.size() == 1 ? " node" : " nodes")
+                      << ", no placement" << std::endl;
+            return;
+        }
+        int strategy_node = exec.strategy_cpu >= 0 ? topo.nodeOfCpu(exec.strategy_cpu) : currentNumaNode();
+        int feed_node = exec.feed_cpu >= 0 ? topo.nodeOfCpu(exec.feed_cpu) : strategy_node;
+        
+        NumaPlacement placement;
+        placement.placeAll("symbol table", symbols, strategy_node);
+        placement.placeAll("order pools", exchange, strategy_node);
+        placement.placeAll("feed ring", feed_ring, strategy_node);
+        placement.placeAll("cycle arena", arena, feed_node);
+        size_t shards = (symbols.size() + QUOTE_SHARD - 1) / QUOTE_SHARD;
+        if(exec.strategy_workers > 0 && exec.worker_cpu >= 0 && shards > 1) {
+            // Runs of shards whose owners share a node, then each run's rows to that node
+            auto nodeOf = [&](size_t shard) {
+                int node = topo.nodeOfCpu(exec.worker_cpu + static_cast<int>(shardOwner(shard, shards)));
+                return node >= 0 ? node : strategy_node;
+            };
+            for(size_t first = 0, i = 1; i <= shards; ++i) {
+                if(i < shards && nodeOf(i) == nodeOf(first)) continue;
+                symbols.rowBlocks(first * QUOTE_SHARD, std::min(symbols.size(), i * QUOTE_SHARD),
+                                  [&](void* p, size_t bytes) { placement.place("quote shards", p, bytes, nodeOf(first)); });
+                first = i;
+            }
+        }
+        
+        std::cout << "  NUMA:       " << topo.size() << " nodes (";
+        for(size_t i = 0; i < topo.size(); ++i) {
+            const NumaNode& n = topo.nodes()[i];
+            std::cout << (i ? "; " : "") << n.id << ": CPUs " << NumaTopology::formatCpuList(n.cpus);
+        }
+        std::cout << "), feed node " << feed_node << ", strategy node " << strategy_node << ", distance "
+                  << topo.distance(feed_node, strategy_node) << std::endl;
+        for(const NumaPlacement::Entry& e : placement.entries()) {
+            std::cout << "              " << e.what << " " << (e.bytes + 1023) / 1024 << " KB -> node " << e.node;
+            if(e.error) std::cout << ": " << std::strerror(e.error);
+            else if(e.in_region == e.bytes) std::cout << " (in the huge-page region)";
+            else std::cout << " (" << e.residency.on_node << "/" << e.residency.pages << " pages there)";
+            std::cout << std::endl;
+        }
+    }
+    
+    // Strategy thread: consumes feed_ring, applies quotes to the table as they arrive and,
+    // when a poll completes, fills, requotes and reports.
     void run(Portfolio *portfolio) {
         std::cout << "Portfolio: " << portfolio->name << std::endl;
         std::cout << "\n╔════════════════════════════════════════╗" << std::endl;
@@ -180,6 +960,19 @@ public:
         std::cout << "  Symbol:     " << symbol << std::endl;
         std::cout << "  Spread:     " << spread_bps << " bps" << std::endl;
         std::cout << "  Order Size: " << share_size << " shares" << std::endl;
+        std::cout << "  Parser:     " << json->name() << " (" << jsonScanner().name << ")" << std::endl;
+        std::cout << "  Pipeline:   " << (bus.subscribe.empty() ? "feed thread" : "bus " + bus.subscribe + " -> feed thread")
+                  << " -> SPSC ring (" << feed_ring.capacity() << " slots, " << toString(feed_ring.policy())
+                  << ") -> strategy thread" << std::endl;
+        openBus();
+        openGateway();
+        std::cout << "  Execution:  " << toString(exec.mode) << ", feed CPU "
+                  << (exec.feed_cpu >= 0 ? std::to_string(exec.feed_cpu) : "any") << ", strategy CPU "
+                  << (exec.strategy_cpu >= 0 ? std::to_string(exec.strategy_cpu) : "any") << ", RT priority "
+                  << (exec.rt_priority > 0 ? std::to_string(exec.rt_priority) : "off") << ", strategy workers "
+                  << (exec.strategy_workers > 0 ? std::to_string(exec.strategy_workers) : "off") << std::endl;
+        setupThread("strategy", exec.strategy_cpu);
+        placeMemory();
         std::cout << "  API Key:    " << (api_key == "demo" ? "DEMO (limited)" : "Custom") << std::endl;
         
         if(api_key == "demo") {
@@ -189,73 +982,172 @@ public:
         
         std::cout << "\nPress Ctrl+C to stop\n" << std::endl;
         
+        std::thread feed([this] {
+            if(bus.subscribe.empty()) feedLoop();
+            else busFeedLoop();
+        });
+        if(exec.strategy_workers > 0) {
+            std::vector<int> cpus;
+            for(int i = 0; exec.worker_cpu >= 0 && i < exec.strategy_workers; ++i) cpus.push_back(exec.worker_cpu + i);
+            workers = std::make_unique<WorkStealingPool>(static_cast<size_t>(exec.strategy_workers), exec.mode, cpus);
+        }
+        if(lowJitterRequested()) prefaultStack();
+        PageFaults loop_start = PageFaults::thisThread();
+        Waiter waiter(exec.mode);
+        
         int cycle = 0;
+        uint64_t allocs_before = heapAllocations();
+        PageFaults faults_before = PageFaults::thisThread();
+        MarketTick tick;
+        auto woken = [this] {
+            return feed_ring.depth() > 0 || strategy_commands.load(std::memory_order_relaxed) || !running;
+        };
         while(running) {
-            auto start = std::chrono::high_resolution_clock::now();
+            if(strategy_commands.load(std::memory_order_relaxed)) runStrategyCommands();
+            if(!feed_ring.pop(tick)) {
+                waiter.idle(strategy_bell, woken);
+                continue;
+            }
+            waiter.reset();
+            int64_t popped_ns = steadyNs();
+            ring_hop.add(popped_ns - tick.decoded_ns);
+            wake_latency.record(popped_ns - tick.decoded_ns);
             
-            // 1. Update market price
-            bool success = updateMarketPrice();
+            // 1. Apply market updates as they arrive
+            if(tick.kind == MarketTick::Kind::Quote) {
+                feed_hop.add(tick.decoded_ns - tick.request_ns);
+                applyQuote(tick.symbol, tick.record());
+                continue;
+            }
             
-            if(!success) {
+            if(tick.kind == MarketTick::Kind::PollFailed) {
+                saveState(portfolio);
                 std::cout << "\n⏳ Waiting for market data..." << std::endl;
                 if(api_key == "demo" && cycle > 5) {
                     std::cout << "⚠️  DEMO key limit may be reached. Get free key at alphavantage.co" << std::endl;
                 }
-                std::this_thread::sleep_for(std::chrono::seconds(5));
                 continue;
             }
             
             cycle++;
             
-            // 2. Calculate latency
-            auto end = std::chrono::high_resolution_clock::now();
-            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+            // Strategy pass: our quotes for every symbol in the table
+            // Fill resting paper orders the new prices traded through, then requote
+            exchange.match([&](const Fill& f) { applyFill(portfolio, f); });
+            computeQuotes();
+            exchange.requote(symbols, steadyNs());
+            collectGatewayResponses();
+            int64_t quoted_ns = steadyNs();
+            strategy_hop.add(quoted_ns - popped_ns);
+            uint64_t strategy_allocs = heapAllocations() - allocs_before;
+            PageFaults strategy_faults = PageFaults::thisThread() - faults_before;
+            FeedStats feed = feed_stats.load();
+            
+            // 2. Calculate latency: poll start to requoted
+            long latency_us = static_cast<long>((quoted_ns - tick.request_ns) / 1000);
             
             // 3. Display stats
-            displayStats(cycle, duration.count());
+            displayStats(cycle, latency_us, feed.first_quote_us);
             
             // 4. Show order book every cycle
             displayOrderBook();
             
             // 5. Show performance metrics
             std::cout << "\n📊 Performance:" << std::endl;
-            std::cout << "   Cycle time:  " << duration.count() / 1000.0 << " ms" << std::endl;
+            std::cout << "   Cycle time:  " << latency_us / 1000.0 << " ms" << std::endl;
             
-            if(duration.count() < 100000) {  // < 100ms
+            if(latency_us < 100000) {  // < 100ms
                 std::cout << "   Status:      ✅ FAST" << std::endl;
-            } else if(duration.count() < 500000) {  // < 500ms
+            } else if(latency_us < 500000) {  // < 500ms
                 std::cout << "   Status:      ⚠️  MODERATE" << std::endl;
             } else {
                 std::cout << "   Status:      ❌ SLOW (optimize needed)" << std::endl;
             }
+            std::cout << "   Heap allocs: feed " << feed.allocs << " (arena " << feed.arena_used << "/"
+                      << arena.capacity() << " bytes, " << feed.arena_spilled << " spilled), strategy "
+                      << strategy_allocs << std::endl;
+            PageFaults total_faults = PageFaults::thisThread() - loop_start;
+            std::cout << "   Page faults: feed " << feed.faults.minor << "/" << feed.faults.major
+                      << ", strategy " << strategy_faults.minor << "/" << strategy_faults.major
+                      << " minor/major this cycle, strategy " << total_faults.minor << "/" << total_faults.major
+                      << " since start" << std::endl;
+            displayPipeline();
             
-            // In production: place/cancel orders here
-            std::cout << "\n💡 Next: Implement order placement with broker API" << std::endl;
+            displayOrders();
+            saveState(portfolio);
+            std::cout << "   Requests today: " << budget.load().requests_today << std::endl;
             
-            // Alpha Vantage free tier: 5 calls/minute, wait 12+ seconds
             int wait_time = (api_key == "demo") ? 15 : 12;
             std::cout << "\nWaiting " << wait_time << " seconds (API rate limit)..." << std::endl;
-            std::this_thread::sleep_for(std::chrono::seconds(wait_time));
+            allocs_before = heapAllocations();
+            faults_before = PageFaults::thisThread();
         }
+        // A feed push blocked on a full ring gives up rather than outwaiting us
+        feed_ring.close();
+        feed.join();
+        workers.reset();
     }
     
+    // Thread-safe; the feed reactor and the strategy thread wake up and return straight away.
     void stop() {
         running = false;
+        reactor.stop();
+        strategy_bell.ring();
+        if(bus_attached.load(std::memory_order_acquire)) bus_in.interrupt();
+    }
+    
+    // Thread-safe; the strategy thread applies the spread to every symbol and requotes as
+    // soon as it wakes.
+    void requestSpread(double bps) {
+        requested_spread.store(SpreadBps::fromBps(bps).centi_bps, std::memory_order_relaxed);
+        command_ns.store(steadyNs(), std::memory_order_relaxed);
+        strategy_commands.fetch_or(CMD_SET_SPREAD, std::memory_order_release);
+        strategy_bell.ring();
+    }
+    
+    // Thread-safe; polls on the next reactor pass unless a poll is already in flight.
+    void requestPoll() {
+        pending_commands.fetch_or(CMD_POLL_NOW);
+        control.signal();
     }
 };
 
 int main(int argc, char* argv[]) {
+    // Blocks SIGINT/SIGTERM for every thread started from here on; the loop below takes
+    // them, so Ctrl+C stops cleanly instead of killing the process mid-cycle
+    ConsoleInput console;
     curl_global_init(CURL_GLOBAL_DEFAULT);
 
+    // Must run before the market maker builds its pools, arena and tables. On a NUMA box
+    // with a pinned strategy thread the region goes to that thread's node.
+    if(lowJitterRequested()) {
+        ExecutionConfig exec = ExecutionConfig::fromEnv();
+        NumaTopology topo = NumaTopology::discover();
+        int node = topo.numa() && exec.numa_placement && exec.strategy_cpu >= 0 ? topo.nodeOfCpu(exec.strategy_cpu) : -1;
+        LowJitterReport jitter = enterLowJitterMode(node);
+        std::cout << "Low-jitter mode: " << jitter.region_bytes / (1024 * 1024) << " MB region on "
+                  << toString(jitter.backing)
+                  << (jitter.node >= 0 ? std::string(" (NUMA node ") + std::to_string(jitter.node) + ")" : std::string())
+                  << ", memory "
+                  << (jitter.locked ? "locked" : std::string("not locked (") + std::strerror(jitter.lock_errno) + ")")
+                  << std::endl;
+    }
+
     MarketMaker mm;
 
     // // Parse command line arguments
+#ifdef HFT_STATIC_CONFIG
+    mm.setSymbol(staticSymbolList<StrategyConfig>());
+    if(argc > 1) std::cout << "Symbol set is compiled in; ignoring " << argv[1] << std::endl;
+#else
     if(argc > 1) mm.setSymbol(argv[1]);
+#endif
     if(argc > 2) mm.setApiKey(argv[2]);
     
     std::cout << "\n📈 HFT Market Maker starting..." << std::endl;
 
     Portfolio portfolio;
+    mm.restoreState(&portfolio);
     std::cout << "Beginning balance: $"
                 << std::fixed
                 << std::setprecision(2)
@@ -267,15 +1159,22 @@ int main(int argc, char* argv[]) {
 
     
     // // Wait for Enter key to stop
-    std::cout << "\nPress Enter to stop...\n" << std::endl;
-    std::cin.get();
+    std::cout << "\nPress Enter or Ctrl+C to stop (p + Enter polls now, s BPS + Enter sets the spread)...\n" << std::endl;
+    for(std::string line; console.next(line) == ConsoleInput::Event::Line;) {
+        if(line == "p") mm.requestPoll();
+        else if(line.size() > 2 && line.compare(0, 2, "s ") == 0) mm.requestSpread(std::strtod(line.c_str() + 2, nullptr));
+        else break;
+    }
     
+    auto stop_start = std::chrono::steady_clock::now();
     mm.stop();
     runner.join();
+    std::cout << "Stopped in " << std::chrono::duration_cast<std::chrono::microseconds>(
+                     std::chrono::steady_clock::now() - stop_start).count() << " μs" << std::endl;
     
     curl_global_cleanup();
     
     // std::cout << "\n✅ Market maker stopped." << std::endl;
-    std::cout << "Ending balance: $" << portfolio.cash << std::endl << std::endl;
+    std::cout << "Ending balance: $" << portfolio.cash.load() << std::endl << std::endl;
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "page_memory.hpp"
+
+constexpr size_t CACHE_LINE = 64;
+
+// Fixed-size, zero-initialized array of trivially copyable T starting on a cache line.
+// Backing store for the dense per-field columns of the state tables, pools and arenas.
+// Placed in the huge-page region when low-jitter mode reserved one (see page_memory.hpp).
+template<class T>
+class AlignedArray {
+    static_assert(std::is_trivially_copyable_v<T>, "AlignedArray holds plain data only");
+
+public:
+    AlignedArray() = default;
+    explicit AlignedArray(size_t n) : count(n) {
+        if(n == 0) return;
+        void* p = HugePageRegion::instance().allocate(bytes(), CACHE_LINE);
+        items = static_cast<T*>(p ? p : ::operator new(bytes(), std::align_val_t(heapAlignment())));
+        std::memset(static_cast<void*>(items), 0, bytes());
+    }
+    AlignedArray(AlignedArray&& o) noexcept : items(std::exchange(o.items, nullptr)), count(std::exchange(o.count, 0)) {}
+    AlignedArray& operator=(AlignedArray&& o) noexcept {
+        if(this != &o) {
+            release();
+            items = std::exchange(o.items, nullptr);
+            count = std::exchange(o.count, 0);
+        }
+        return *this;
+    }
+    AlignedArray(const AlignedArray&) = delete;
+    AlignedArray& operator=(const AlignedArray&) = delete;
+    ~AlignedArray() { release(); }
+
+    T& operator[](size_t i) { return items[i]; }
+    const T& operator[](size_t i) const { return items[i]; }
+    T* data() { return items; }
+    const T* data() const { return items; }
+    size_t size() const { return count; }
+    // Bytes reserved, rounded up to whole cache lines.
+    size_t bytes() const { return (count * sizeof(T) + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE; }
+
+private:
+    // Arrays of a page or more start on a page of their own, so moving them to a NUMA node
+    // (numa.hpp) does not drag their neighbours along.
+    size_t heapAlignment() const { return bytes() >= SMALL_PAGE ? SMALL_PAGE : CACHE_LINE; }
+
+    void release() {
+        if(items && !HugePageRegion::instance().contains(items)) ::operator delete(items, std::align_val_t(heapAlignment()));
+        items = nullptr;
+    }
+
+    T* items = nullptr;
+    size_t count = 0;
+};
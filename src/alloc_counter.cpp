@@ -0,0 +1,38 @@
+#include "alloc_counter.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    thread_local uint64_t allocations = 0;
+
+    void* allocate(std::size_t n) {
+        ++allocations;
+        if(void* p = std::malloc(n ? n : 1)) return p;
+        throw std::bad_alloc();
+    }
+
+    void* allocateAligned(std::size_t n, std::align_val_t al) {
+        ++allocations;
+        std::size_t align = static_cast<std::size_t>(al);
+        std::size_t size = (n + align - 1) / align * align;
+        if(void* p = std::aligned_alloc(align, size ? size : align)) return p;
+        throw std::bad_alloc();
+    }
+}
+
+uint64_t heapAllocations() { return allocations; }
+
+void* operator new(std::size_t n) { return allocate(n); }
+void* operator new[](std::size_t n) { return allocate(n); }
+void* operator new(std::size_t n, std::align_val_t al) { return allocateAligned(n, al); }
+void* operator new[](std::size_t n, std::align_val_t al) { return allocateAligned(n, al); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
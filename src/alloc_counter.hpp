@@ -0,0 +1,12 @@
+#pragma once
+#include <cstdint>
+
+// Counts heap allocations made through global operator new on the calling thread, so a
+// loop can report how many allocations one pass made (the target for the hot path is 0).
+//
+// The replaceable global operator new/delete that do the counting live in
+// alloc_counter.cpp; link it into every executable that includes this header. Allocations
+// made by C libraries through malloc (libcurl, for example) are not counted.
+
+// Heap allocations made by this thread so far; take the difference around a pass.
+uint64_t heapAllocations();
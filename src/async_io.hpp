@@ -0,0 +1,91 @@
+#pragma once
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "async_timers.hpp"
+#include "http_multi.hpp"
+#include "task.hpp"
+
+// Awaitables for Tasks running on a reactor thread:
+//   co_await timers.sleepUntil(t) / sleepFor(d)   resume at a deadline
+//   co_await alarm.until(t)                        same, but alarm.fire() can cut it short
+//   co_await fetch(http, req, url, write, data)    resume with the CURLcode of an HTTP GET
+// Everything resumes on the reactor thread; none of it is thread-safe.
+
+// A sleep that can be cut short: co_await alarm.until(t) resumes at t or at the first
+// fire(), whichever comes first. One coroutine waits on an alarm at a time.
+class Alarm : private TimerNode {
+public:
+    explicit Alarm(AsyncTimers& t) : TimerNode(wake), timers(t) {}
+    Alarm(const Alarm&) = delete;
+    Alarm& operator=(const Alarm&) = delete;
+    ~Alarm() { timers.cancel(*this); }
+
+    struct Awaiter {
+        // Also runs when the waiting coroutine is destroyed mid-sleep
+        ~Awaiter() {
+            alarm.timers.cancel(alarm);
+            alarm.waiter = {};
+        }
+
+        Alarm& alarm;
+        AsyncTimers::Clock::time_point deadline;
+
+        bool await_ready() const { return deadline <= AsyncTimers::Clock::now(); }
+        void await_suspend(std::coroutine_handle<> h) {
+            alarm.waiter = h;
+            alarm.timers.schedule(alarm, deadline);
+        }
+        void await_resume() noexcept {}
+    };
+
+    Awaiter until(AsyncTimers::Clock::time_point deadline) { return Awaiter{*this, deadline}; }
+
+    // Resumes the waiting coroutine now, on the calling thread. False if nothing waits.
+    bool fire() {
+        if(!waiter) return false;
+        timers.cancel(*this);
+        std::exchange(waiter, {}).resume();
+        return true;
+    }
+    bool waiting() const { return static_cast<bool>(waiter); }
+
+private:
+    static void wake(TimerNode* n) {
+        Alarm* self = static_cast<Alarm*>(n);
+        std::exchange(self->waiter, {}).resume();
+    }
+
+    AsyncTimers& timers;
+    std::coroutine_handle<> waiter;
+};
+
+// co_await fetch(...) starts an HTTP GET on the multi handle and resumes with its result
+// (CURLE_FAILED_INIT if it could not start, e.g. because req is already in flight).
+struct FetchAwaiter {
+    HttpMulti& http;
+    HttpRequest& req;
+    const std::string& url;
+    curl_write_callback write;
+    void* userdata;
+    CURLcode result = CURLE_OK;
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> h) {
+        bool started = http.get(req, url, write, userdata, [this, h](CURLcode res) {
+            result = res;
+            h.resume();
+        });
+        if(!started) result = CURLE_FAILED_INIT;
+        return started;
+    }
+    CURLcode await_resume() const noexcept { return result; }
+};
+
+inline FetchAwaiter fetch(HttpMulti& http, HttpRequest& req, const std::string& url, curl_write_callback write,
+                          void* userdata) {
+    return FetchAwaiter{http, req, url, write, userdata};
+}
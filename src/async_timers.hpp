@@ -0,0 +1,101 @@
+#pragma once
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+
+#include "reactor.hpp"
+#include "timer_wheel.hpp"
+
+// Sleepers and timer events behind a single timerfd, kept in a TimerWheel at tick
+// resolution (100 us by default). Sleep awaiters and alarms carry their own TimerNode, so scheduling never
+// allocates, and a coroutine destroyed while asleep unschedules itself.
+class AsyncTimers {
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr std::chrono::nanoseconds DEFAULT_TICK = std::chrono::microseconds(100);
+
+    explicit AsyncTimers(Reactor& r, std::chrono::nanoseconds tick = DEFAULT_TICK)
+        : reactor(r), tick_ns(tick.count()), origin_ns(toNs(Clock::now())) {
+        reactor.add(timer.fd(), EPOLLIN, [this](uint32_t) {
+            timer.drain();
+            expire();
+        });
+    }
+    AsyncTimers(const AsyncTimers&) = delete;
+    AsyncTimers& operator=(const AsyncTimers&) = delete;
+    ~AsyncTimers() { reactor.remove(timer.fd()); }
+
+    struct SleepAwaiter : TimerNode {
+        SleepAwaiter(AsyncTimers& t, Clock::time_point d) : TimerNode(wake), timers(t), deadline(d) {}
+        ~SleepAwaiter() { timers.cancel(*this); }
+
+        bool await_ready() const { return deadline <= Clock::now(); }
+        void await_suspend(std::coroutine_handle<> h) {
+            handle = h;
+            timers.schedule(*this, deadline);
+        }
+        void await_resume() noexcept {}
+
+        static void wake(TimerNode* n) { static_cast<SleepAwaiter*>(n)->handle.resume(); }
+
+        AsyncTimers& timers;
+        Clock::time_point deadline;
+        std::coroutine_handle<> handle;
+    };
+
+    SleepAwaiter sleepUntil(Clock::time_point deadline) { return SleepAwaiter(*this, deadline); }
+    SleepAwaiter sleepFor(Clock::duration d) { return sleepUntil(Clock::now() + d); }
+
+    // Timer events for plain callbacks (the poll alarm, curl's timeouts): node.fire runs on
+    // the reactor thread once deadline has passed. Rescheduling a scheduled node moves it.
+    void schedule(TimerNode& node, Clock::time_point deadline) {
+        wheel.schedule(node, tickFor(deadline));
+        rearm();
+    }
+    void cancel(TimerNode& node) { wheel.cancel(node); }
+
+    size_t pending() const { return wheel.size(); }
+    // Unschedules everything without firing it.
+    void clear() {
+        wheel.clear();
+        rearm();
+    }
+
+private:
+    static int64_t toNs(Clock::time_point t) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+    }
+
+    // Rounded up, so nothing fires early.
+    uint64_t tickFor(Clock::time_point t) const {
+        int64_t ns = toNs(t) - origin_ns;
+        return ns <= 0 ? 0 : static_cast<uint64_t>((ns + tick_ns - 1) / tick_ns);
+    }
+    uint64_t currentTick() const { return static_cast<uint64_t>((toNs(Clock::now()) - origin_ns) / tick_ns); }
+
+    void expire() {
+        armed_tick = TimerWheel::NO_TIMER;
+        wheel.advance(currentTick());
+        rearm();
+    }
+
+    // Points the timerfd at the wheel's next tick with work, unless it already is.
+    void rearm() {
+        uint64_t next = wheel.nextWake();
+        if(next == armed_tick) return;
+        armed_tick = next;
+        if(next == TimerWheel::NO_TIMER) {
+            timer.disarm();
+            return;
+        }
+        int64_t due_ns = origin_ns + static_cast<int64_t>(next) * tick_ns;
+        timer.arm(std::chrono::nanoseconds(due_ns - toNs(Clock::now())));
+    }
+
+    Reactor& reactor;
+    TimerFd timer;
+    TimerWheel wheel;
+    int64_t tick_ns;
+    int64_t origin_ns;
+    uint64_t armed_tick = TimerWheel::NO_TIMER;
+};
@@ -0,0 +1,62 @@
+#pragma once
+#include <cerrno>
+#include <poll.h>
+#include <signal.h>
+#include <string>
+#include <unistd.h>
+
+#include "reactor.hpp"
+
+// Line commands on stdin and SIGINT/SIGTERM, waited for together with poll(2), so Ctrl+C
+// ends the wait as promptly as a typed command. stdin is read unbuffered (no std::cin), so
+// poll sees every byte; works on terminals, pipes and files alike. Construct in main()
+// before any thread starts (see SignalFd).
+class ConsoleInput {
+public:
+    enum class Event : uint8_t { Line, Signal, Closed };
+
+    explicit ConsoleInput(int fd = STDIN_FILENO) : in(fd), signals{SIGINT, SIGTERM} {}
+
+    // Blocks for the next line (without its newline), a signal or the end of input.
+    Event next(std::string& line) {
+        for(;;) {
+            size_t nl = buffer.find('\n');
+            if(nl != std::string::npos) {
+                line.assign(buffer, 0, nl);
+                buffer.erase(0, nl + 1);
+                return Event::Line;
+            }
+            if(eof) {
+                if(buffer.empty()) return Event::Closed;
+                line.swap(buffer);
+                buffer.clear();
+                return Event::Line;
+            }
+            pollfd fds[2] = {{in, POLLIN, 0}, {signals.fd(), POLLIN, 0}};
+            if(poll(fds, 2, -1) < 0) {
+                if(errno == EINTR) continue;
+                return Event::Closed;
+            }
+            if(fds[1].revents & POLLIN) {
+                last_signal = signals.take();
+                return Event::Signal;
+            }
+            if(fds[0].revents) {
+                char chunk[256];
+                ssize_t n = read(in, chunk, sizeof(chunk));
+                if(n > 0) buffer.append(chunk, static_cast<size_t>(n));
+                else if(n == 0 || errno != EINTR) eof = true;
+            }
+        }
+    }
+
+    // The signal behind the last Event::Signal.
+    int signal() const { return last_signal; }
+
+private:
+    int in;
+    SignalFd signals;
+    std::string buffer;
+    bool eof = false;
+    int last_signal = 0;
+};
@@ -0,0 +1,338 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <immintrin.h>
+
+#include "json_scan.hpp"
+#include "market_data.hpp"
+
+// Vectorized decoder for Alpha Vantage datatype=csv responses:
+//   TIME_SERIES_INTRADAY  timestamp,open,high,low,close,volume
+//   REALTIME_BULK_QUOTES  symbol,timestamp,open,high,low,close,volume,previous_close,change,change_percent,...
+// Rows and fields are split by classifying 64 bytes at a time into a bitmask of ',' and '\n'
+// (same runtime-dispatched ISA choice as the JSON scanner), and numeric fields are converted
+// straight into fixed-point column arrays. Columns are located by header name, so extra or
+// reordered columns are fine. Alpha Vantage never quotes fields; quoted CSV is not supported.
+
+namespace csv_detail {
+    inline uint64_t maskScalar(const char* p, size_t n) {
+        uint64_t mask = 0;
+        for(size_t i = 0; i < n; ++i) mask |= static_cast<uint64_t>(p[i] == ',' || p[i] == '\n') << i;
+        return mask;
+    }
+
+    __attribute__((target("sse4.2")))
+    inline uint64_t maskSse42(const char* p, size_t n) {
+        if(n < 64) return maskScalar(p, n);
+        const __m128i set = _mm_setr_epi8(',', '\n', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+        constexpr int mode = _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_BIT_MASK;
+        uint64_t mask = 0;
+        for(int i = 0; i < 4; ++i) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * i));
+            uint64_t bits = static_cast<uint16_t>(_mm_cvtsi128_si32(_mm_cmpestrm(set, 2, chunk, 16, mode)));
+            mask |= bits << (16 * i);
+        }
+        return mask;
+    }
+
+    __attribute__((target("avx2")))
+    inline uint32_t maskAvx2Half(const char* p) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i m = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(',')),
+                                    _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')));
+        return static_cast<uint32_t>(_mm256_movemask_epi8(m));
+    }
+
+    __attribute__((target("avx2")))
+    inline uint64_t maskAvx2(const char* p, size_t n) {
+        if(n < 64) return maskScalar(p, n);
+        return static_cast<uint64_t>(maskAvx2Half(p)) | static_cast<uint64_t>(maskAvx2Half(p + 32)) << 32;
+    }
+
+    inline constexpr BlockMaskFn KERNELS[] = {maskScalar, maskSse42, maskAvx2};
+}
+
+// Delimiter classifier for the ISA the JSON scanner selected (honours HFT_SIMD too).
+inline BlockMaskFn csvDelimiterMask(ScanIsa isa = jsonScanner().isa) {
+    return csv_detail::KERNELS[static_cast<int>(isa)];
+}
+
+// Intraday bars as fixed-point columns (prices in ticks, time as yyyymmddhhmmss).
+struct IntradayColumns {
+    std::vector<int64_t> time;
+    std::vector<int64_t> open;
+    std::vector<int64_t> high;
+    std::vector<int64_t> low;
+    std::vector<int64_t> close;
+    std::vector<int64_t> volume;
+
+    size_t size() const { return time.size(); }
+    void clear() {
+        for(auto* col : {&time, &open, &high, &low, &close, &volume}) col->clear();
+    }
+    Bar bar(size_t i) const {
+        Bar b;
+        b.time = time[i];
+        b.open = open[i];
+        b.high = high[i];
+        b.low = low[i];
+        b.close = close[i];
+        b.volume = volume[i];
+        b.present = (1u << static_cast<int>(BarField::Count)) - 1;
+        return b;
+    }
+};
+
+// Bulk quotes as fixed-point columns; present carries the QuoteField bits per row.
+struct QuoteColumns {
+    std::vector<std::array<char, SYMBOL_CAPACITY>> symbol;
+    std::vector<int64_t> open;
+    std::vector<int64_t> high;
+    std::vector<int64_t> low;
+    std::vector<int64_t> price;
+    std::vector<int64_t> volume;
+    std::vector<int64_t> previous_close;
+    std::vector<int64_t> change;
+    std::vector<int64_t> change_percent;
+    std::vector<int32_t> trading_day;
+    std::vector<uint16_t> present;
+
+    size_t size() const { return symbol.size(); }
+    void clear() {
+        symbol.clear();
+        for(auto* col : {&open, &high, &low, &price, &volume, &previous_close, &change, &change_percent}) col->clear();
+        trading_day.clear();
+        present.clear();
+    }
+    QuoteRecord record(size_t i) const {
+        QuoteRecord r;
+        std::memcpy(r.symbol, symbol[i].data(), SYMBOL_CAPACITY);
+        r.open = open[i];
+        r.high = high[i];
+        r.low = low[i];
+        r.price = price[i];
+        r.volume = volume[i];
+        r.previous_close = previous_close[i];
+        r.change = change[i];
+        r.change_percent = change_percent[i];
+        r.trading_day = trading_day[i];
+        r.present = present[i];
+        return r;
+    }
+};
+
+// Chunk-fed CSV decoder. Complete rows are decoded in place from each chunk; only a
+// trailing partial line is copied and carried to the next chunk.
+class CsvDecoder {
+public:
+    enum class Layout : uint8_t { Intraday, BulkQuotes };
+
+    using QuoteSink = std::function<void(const QuoteRecord&)>;
+
+    explicit CsvDecoder(Layout layout, BlockMaskFn maskFn = csvDelimiterMask()) : kind(layout), classify(maskFn) {}
+
+    // Optional per-row callback for bulk quotes, invoked as each row is decoded.
+    void setQuoteSink(QuoteSink sink) { onQuote = std::move(sink); }
+
+    void reset() {
+        carry.clear();
+        head.clear();
+        plan.clear();
+        header_seen = false;
+        header_rejected = false;
+        rows = 0;
+        malformed = false;
+        bars.clear();
+        quotes.clear();
+    }
+
+    void feed(const char* data, size_t n) {
+        if(head.size() < HEAD_BYTES) head.append(data, std::min(n, HEAD_BYTES - head.size()));
+        if(header_rejected) return;                // not CSV we know; keep only the head for the report
+        const char* end = data + n;
+        if(!carry.empty()) {
+            // Complete the carried line with this chunk's first newline, then continue in place
+            const char* nl = static_cast<const char*>(std::memchr(data, '\n', n));
+            if(!nl) {
+                carry.append(data, n);
+                return;
+            }
+            carry.append(data, static_cast<size_t>(nl + 1 - data));
+            decodeLines(carry.data(), carry.data() + carry.size());
+            carry.clear();
+            data = nl + 1;
+        }
+        const char* consumed = decodeLines(data, end);
+        carry.assign(consumed, static_cast<size_t>(end - consumed));
+    }
+
+    // Decodes a final line that had no trailing newline.
+    void finish() {
+        if(carry.empty() || header_rejected) return;
+        carry.push_back('\n');
+        decodeLines(carry.data(), carry.data() + carry.size());
+        carry.clear();
+    }
+
+    size_t rowCount() const { return rows; }
+    // Header missing/unrecognized (e.g. a JSON error body) or a row failed to parse.
+    bool failed() const { return malformed || (!header_seen && !head.empty()); }
+    const std::string& bodyHead() const { return head; }
+
+    IntradayColumns bars;
+    QuoteColumns quotes;
+
+private:
+    static constexpr size_t HEAD_BYTES = 512;
+    static constexpr int MAX_COLUMNS = 32;
+    static constexpr int8_t SKIP = -1;
+    static constexpr int8_t TIME_SLOT = static_cast<int8_t>(BarField::Count);
+
+    // Decodes every complete line in [begin, end); returns the start of the unfinished tail.
+    const char* decodeLines(const char* begin, const char* end) {
+        BlockMaskCursor cur(begin, end, classify);
+        const char* lineStart = begin;
+        const char* fieldStart = begin;
+        std::string_view fields[MAX_COLUMNS];
+        int col = 0;
+
+        for(const char* d = cur.next(); d != end; d = cur.next()) {
+            const char* fieldEnd = d;
+            if(*d == '\n' && fieldEnd > fieldStart && fieldEnd[-1] == '\r') --fieldEnd;
+            if(col < MAX_COLUMNS) fields[col] = std::string_view(fieldStart, static_cast<size_t>(fieldEnd - fieldStart));
+            ++col;
+            fieldStart = d + 1;
+            if(*d == '\n') {
+                if(col > 1 || !fields[0].empty()) row(fields, std::min(col, MAX_COLUMNS));
+                col = 0;
+                lineStart = d + 1;
+            }
+        }
+        return lineStart;
+    }
+
+    void row(const std::string_view* fields, int count) {
+        if(!header_seen) {
+            if(!header_rejected) header(fields, count);
+            return;
+        }
+        if(count < static_cast<int>(plan.size())) {
+            malformed = true;
+            return;
+        }
+        if(kind == Layout::Intraday) barRow(fields);
+        else quoteRow(fields);
+    }
+
+    void header(const std::string_view* fields, int count) {
+        plan.assign(static_cast<size_t>(count), SKIP);
+        bool hasKey = false;
+        for(int i = 0; i < count; ++i) {
+            if(kind == Layout::Intraday) {
+                BarField field;
+                if(fields[i] == "timestamp") { plan[i] = TIME_SLOT; hasKey = true; }
+                else if(csvBarField(fields[i], field)) plan[i] = static_cast<int8_t>(field);
+            } else {
+                QuoteField field;
+                if(bulkQuoteField(fields[i], field)) {
+                    plan[i] = static_cast<int8_t>(field);
+                    hasKey = hasKey || field == QuoteField::Symbol;
+                }
+            }
+        }
+        header_seen = hasKey;
+        if(!hasKey) {
+            // The first line decides; later rows are never taken for a header
+            plan.clear();
+            header_rejected = true;
+            malformed = true;
+        }
+    }
+
+    static bool csvBarField(std::string_view name, BarField& out) {
+        static constexpr std::string_view NAMES[] = {"open", "high", "low", "close", "volume"};
+        for(int i = 0; i < static_cast<int>(BarField::Count); ++i) {
+            if(NAMES[i] == name) { out = static_cast<BarField>(i); return true; }
+        }
+        return false;
+    }
+
+    void barRow(const std::string_view* fields) {
+        Bar bar;
+        bool ok = true;
+        for(size_t i = 0; i < plan.size(); ++i) {
+            if(plan[i] == TIME_SLOT) ok = ok && parseDateTime(fields[i], bar.time);
+            else if(plan[i] != SKIP) ok = ok && applyBarField(bar, static_cast<BarField>(plan[i]), fields[i]);
+        }
+        if(!ok) {
+            malformed = true;
+            return;
+        }
+        bars.time.push_back(bar.time);
+        bars.open.push_back(bar.open);
+        bars.high.push_back(bar.high);
+        bars.low.push_back(bar.low);
+        bars.close.push_back(bar.close);
+        bars.volume.push_back(bar.volume);
+        ++rows;
+    }
+
+    void quoteRow(const std::string_view* fields) {
+        QuoteRecord rec;
+        for(size_t i = 0; i < plan.size(); ++i) {
+            if(plan[i] != SKIP) applyQuoteField(rec, static_cast<QuoteField>(plan[i]), fields[i]);
+        }
+        if(!rec.has(QuoteField::Symbol)) {
+            malformed = true;
+            return;
+        }
+        quotes.symbol.emplace_back();
+        std::memcpy(quotes.symbol.back().data(), rec.symbol, SYMBOL_CAPACITY);
+        quotes.open.push_back(rec.open);
+        quotes.high.push_back(rec.high);
+        quotes.low.push_back(rec.low);
+        quotes.price.push_back(rec.price);
+        quotes.volume.push_back(rec.volume);
+        quotes.previous_close.push_back(rec.previous_close);
+        quotes.change.push_back(rec.change);
+        quotes.change_percent.push_back(rec.change_percent);
+        quotes.trading_day.push_back(rec.trading_day);
+        quotes.present.push_back(rec.present);
+        ++rows;
+        if(onQuote) onQuote(rec);
+    }
+
+    Layout kind;
+    BlockMaskFn classify;
+    QuoteSink onQuote;
+    std::string carry;
+    std::string head;
+    std::vector<int8_t> plan;  // CSV column -> BarField/QuoteField slot, TIME_SLOT or SKIP
+    bool header_seen = false;
+    bool header_rejected = false;  // first line was not a known header; the rest is ignored
+    size_t rows = 0;
+    bool malformed = false;
+};
+
+// Whole-body conveniences.
+inline size_t decodeIntradayCsv(std::string_view body, IntradayColumns& out, BlockMaskFn maskFn = csvDelimiterMask()) {
+    CsvDecoder decoder(CsvDecoder::Layout::Intraday, maskFn);
+    decoder.bars = std::move(out);
+    decoder.feed(body.data(), body.size());
+    decoder.finish();
+    out = std::move(decoder.bars);
+    return decoder.rowCount();
+}
+
+inline size_t decodeBulkQuotesCsv(std::string_view body, QuoteColumns& out, BlockMaskFn maskFn = csvDelimiterMask()) {
+    CsvDecoder decoder(CsvDecoder::Layout::BulkQuotes, maskFn);
+    decoder.quotes = std::move(out);
+    decoder.feed(body.data(), body.size());
+    decoder.finish();
+    out = std::move(decoder.quotes);
+    return decoder.rowCount();
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+#include "aligned.hpp"
+
+// Monotonic arena for one poll/parse/quote cycle. Every transient allocation of the cycle
+// (response bodies, scratch strings) bumps a pointer in a preallocated block; nothing is
+// freed individually and reset() rewinds the whole block at cycle end. Requests that do
+// not fit spill to the upstream resource and are released on the next reset(), so an
+// undersized arena still works but shows up in overflows().
+class CycleArena : public std::pmr::memory_resource {
+public:
+    explicit CycleArena(size_t capacity, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : block(capacity), spill(upstream) {}
+    CycleArena(const CycleArena&) = delete;
+    CycleArena& operator=(const CycleArena&) = delete;
+
+    void reset() {
+        peak = std::max(peak, offset);
+        offset = 0;
+        if(spilled) spill.release();
+        spilled = 0;
+    }
+
+    // Bytes handed out from the block since the last reset.
+    size_t used() const { return offset; }
+    size_t highWater() const { return std::max(peak, offset); }
+    size_t capacity() const { return block.size(); }
+    // Allocations this cycle that did not fit in the block.
+    size_t overflows() const { return spilled; }
+
+    // fn(data, bytes) for the block (NUMA placement); spills come from upstream.
+    template<class Fn>
+    void memoryBlocks(Fn&& fn) { fn(block.data(), block.bytes()); }
+
+private:
+    void* do_allocate(size_t bytes, size_t align) override {
+        size_t start = (offset + align - 1) & ~(align - 1);
+        if(start + bytes <= block.size()) {
+            offset = start + bytes;
+            return block.data() + start;
+        }
+        ++spilled;
+        return spill.allocate(bytes, align);
+    }
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    AlignedArray<std::byte> block;
+    std::pmr::monotonic_buffer_resource spill;
+    size_t offset = 0;
+    size_t peak = 0;
+    size_t spilled = 0;
+};
@@ -0,0 +1,105 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+// Exception-free fixed-point decimal parsing.
+// Alpha Vantage sends prices as strings with four decimals ("123.4500"). They are converted
+// straight into integer ticks of 10^-Decimals: no locale, no double rounding, no throw.
+
+enum class DecimalStatus : uint8_t {
+    Ok,
+    Empty,        // no digits
+    InvalidChar,  // anything other than [+-]digits[.digits]
+    Overflow,     // does not fit int64 at the requested scale
+    TooPrecise    // non-zero digits beyond the requested scale
+};
+
+inline const char* toString(DecimalStatus status) {
+    switch(status) {
+        case DecimalStatus::Ok: return "ok";
+        case DecimalStatus::Empty: return "empty";
+        case DecimalStatus::InvalidChar: return "invalid character";
+        case DecimalStatus::Overflow: return "overflow";
+        case DecimalStatus::TooPrecise: return "too many decimals";
+    }
+    return "unknown";
+}
+
+// Prices and money are carried with four implied decimals.
+constexpr int PRICE_DECIMALS = 4;
+constexpr int64_t PRICE_SCALE = 10'000;
+
+namespace decimal_detail {
+    constexpr uint64_t POW10[] = {
+        1ull, 10ull, 100ull, 1'000ull, 10'000ull, 100'000ull, 1'000'000ull, 10'000'000ull,
+        100'000'000ull, 1'000'000'000ull, 10'000'000'000ull, 100'000'000'000ull,
+        1'000'000'000'000ull, 10'000'000'000'000ull, 100'000'000'000'000ull,
+        1'000'000'000'000'000ull, 10'000'000'000'000'000ull, 100'000'000'000'000'000ull,
+        1'000'000'000'000'000'000ull
+    };
+
+    // Accumulates up to max digits from [p, end). Stops at the first non-digit.
+    inline const char* digits(const char* p, const char* end, uint64_t& acc, int& count, int max) {
+        while(p < end) {
+            unsigned d = static_cast<unsigned char>(*p) - '0';
+            if(d > 9 || count == max) break;
+            acc = acc * 10 + d;
+            ++count;
+            ++p;
+        }
+        return p;
+    }
+}
+
+// Parses [+-]digits[.digits] into value * 10^Decimals. At most 18 significant digits.
+template<int Decimals>
+inline DecimalStatus parseFixed(std::string_view text, int64_t& out) {
+    static_assert(Decimals >= 0 && Decimals <= 18, "scale out of range");
+    using namespace decimal_detail;
+
+    const char* p = text.data();
+    const char* end = p + text.size();
+    if(p == end) return DecimalStatus::Empty;
+
+    bool negative = *p == '-';
+    p += (*p == '-') | (*p == '+');
+
+    uint64_t whole = 0;
+    int wholeDigits = 0;
+    const char* wholeEnd = digits(p, end, whole, wholeDigits, 19);
+    if(wholeDigits > 18 - Decimals) return DecimalStatus::Overflow;
+    p = wholeEnd;
+
+    uint64_t frac = 0;
+    int fracDigits = 0;
+    bool hasPoint = p < end && *p == '.';
+    if(hasPoint) {
+        p = digits(p + 1, end, frac, fracDigits, Decimals);
+        // digits past the scale are only allowed if they are zero ("123.450000")
+        while(p < end && *p == '0') ++p;
+        if(p < end && static_cast<unsigned>(static_cast<unsigned char>(*p) - '0') <= 9u) return DecimalStatus::TooPrecise;
+    }
+
+    if(wholeDigits + fracDigits == 0) return hasPoint || p == end ? DecimalStatus::Empty : DecimalStatus::InvalidChar;
+    if(p != end) return DecimalStatus::InvalidChar;
+
+    uint64_t magnitude = whole * POW10[Decimals] + frac * POW10[Decimals - fracDigits];
+    out = negative ? -static_cast<int64_t>(magnitude) : static_cast<int64_t>(magnitude);
+    return DecimalStatus::Ok;
+}
+
+// Price string to ticks of 10^-PRICE_DECIMALS.
+inline DecimalStatus parsePrice(std::string_view text, int64_t& ticks) {
+    return parseFixed<PRICE_DECIMALS>(text, ticks);
+}
+
+// Whole number (volume, share counts).
+inline DecimalStatus parseInteger(std::string_view text, int64_t& value) {
+    return parseFixed<0>(text, value);
+}
+
+// "0.6239%" to units of 10^-4 percent (6239 = 0.6239%).
+inline DecimalStatus parsePercent(std::string_view text, int64_t& value) {
+    if(!text.empty() && text.back() == '%') text.remove_suffix(1);
+    return parseFixed<PRICE_DECIMALS>(text, value);
+}
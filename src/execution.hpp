@@ -0,0 +1,179 @@
+#pragma once
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <thread>
+
+// Execution mode for the feed and strategy threads.
+//   sleep   block in the scheduler between events (lowest CPU use, pays wake-up latency)
+//   hybrid  spin with pause for a short window, then yield, then sleep
+//   spin    busy-poll with pause; owns its core, so pair it with pinning
+// Threads can be pinned to cores (HFT_FEED_CPU, HFT_STRATEGY_CPU) and given SCHED_FIFO
+// priority (HFT_RT_PRIORITY) when the process is permitted; failures are reported and
+// the thread carries on unpinned / time-shared.
+
+enum class WaitMode : uint8_t { Sleep, Hybrid, Spin };
+
+inline const char* toString(WaitMode m) {
+    switch(m) {
+        case WaitMode::Hybrid: return "hybrid";
+        case WaitMode::Spin: return "spin";
+        default: return "sleep";
+    }
+}
+
+inline bool parseWaitMode(const char* s, WaitMode& out) {
+    if(!s) return false;
+    if(std::strcmp(s, "sleep") == 0) out = WaitMode::Sleep;
+    else if(std::strcmp(s, "hybrid") == 0) out = WaitMode::Hybrid;
+    else if(std::strcmp(s, "spin") == 0) out = WaitMode::Spin;
+    else return false;
+    return true;
+}
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+// Wake-up for a thread that parks when it runs out of work: a futex (std::atomic::wait)
+// plus a parked flag, so ring() costs a fence and a load unless the thread is actually
+// parked. Whoever hands the thread work, a command or a stop request rings after
+// publishing it; one thread parks on a bell at a time.
+class Doorbell {
+public:
+    void ring() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(!parked.load(std::memory_order_relaxed)) return;
+        seq.fetch_add(1, std::memory_order_release);
+        seq.notify_one();
+    }
+
+    // Blocks until the next ring() unless ready() is already true once parked, which closes
+    // the gap between the caller's last check and the wait. ready() must check everything
+    // that rings this bell. May return spuriously.
+    template<class Ready>
+    void park(Ready&& ready) {
+        uint32_t seen = seq.load(std::memory_order_acquire);
+        parked.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(!ready()) seq.wait(seen, std::memory_order_acquire);
+        parked.store(false, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint32_t> seq{0};
+    std::atomic<bool> parked{false};
+};
+
+// Idle step for a polling loop: call idle() each time a poll finds nothing and reset()
+// once it finds work, so hybrid mode starts each gap with its spin window. With a
+// Doorbell, the sleeping stage parks until rung instead of sleeping in 100 us steps.
+class Waiter {
+public:
+    static constexpr int SPIN_LIMIT = 20'000;   // ~1ms of pause on current cores
+    static constexpr int YIELD_LIMIT = 100;
+    static constexpr auto SLEEP_STEP = std::chrono::microseconds(100);
+
+    explicit Waiter(WaitMode m = WaitMode::Sleep) : mode(m) {}
+
+    void idle() {
+        switch(mode) {
+            case WaitMode::Spin:
+                cpuRelax();
+                break;
+            case WaitMode::Hybrid:
+                if(spins < SPIN_LIMIT) { ++spins; cpuRelax(); }
+                else if(yields < YIELD_LIMIT) { ++yields; std::this_thread::yield(); }
+                else std::this_thread::sleep_for(SLEEP_STEP);
+                break;
+            default:
+                std::this_thread::sleep_for(SLEEP_STEP);
+        }
+    }
+
+    // Bell is a Doorbell or anything else with park(ready), e.g. a MarketBusSubscriber.
+    template<class Bell, class Ready>
+    void idle(Bell& bell, Ready&& ready) {
+        switch(mode) {
+            case WaitMode::Spin:
+                cpuRelax();
+                break;
+            case WaitMode::Hybrid:
+                if(spins < SPIN_LIMIT) { ++spins; cpuRelax(); }
+                else if(yields < YIELD_LIMIT) { ++yields; std::this_thread::yield(); }
+                else bell.park(ready);
+                break;
+            default:
+                bell.park(ready);
+        }
+    }
+
+    void reset() {
+        spins = 0;
+        yields = 0;
+    }
+
+    WaitMode waitMode() const { return mode; }
+
+private:
+    WaitMode mode;
+    int spins = 0;
+    int yields = 0;
+};
+
+struct ExecutionConfig {
+    WaitMode mode = WaitMode::Sleep;
+    int feed_cpu = -1;       // -1: not pinned
+    int strategy_cpu = -1;
+    int rt_priority = 0;     // SCHED_FIFO priority, 0: normal scheduling
+    int strategy_workers = 0; // work-stealing pool for the strategy pass, 0: inline
+    int worker_cpu = -1;     // first CPU of the workers (one each, consecutive), -1: not pinned
+    bool numa_placement = true; // move each structure to its owner's NUMA node (multi-node only)
+
+    // HFT_WAIT_MODE=sleep|hybrid|spin, HFT_FEED_CPU, HFT_STRATEGY_CPU, HFT_RT_PRIORITY,
+    // HFT_STRATEGY_WORKERS, HFT_WORKER_CPU, HFT_NUMA=0 (no placement).
+    static ExecutionConfig fromEnv() {
+        ExecutionConfig c;
+        parseWaitMode(std::getenv("HFT_WAIT_MODE"), c.mode);
+        c.feed_cpu = envInt("HFT_FEED_CPU", -1);
+        c.strategy_cpu = envInt("HFT_STRATEGY_CPU", -1);
+        c.rt_priority = envInt("HFT_RT_PRIORITY", 0);
+        c.strategy_workers = envInt("HFT_STRATEGY_WORKERS", 0);
+        c.worker_cpu = envInt("HFT_WORKER_CPU", -1);
+        c.numa_placement = envInt("HFT_NUMA", 1) != 0;
+        return c;
+    }
+
+private:
+    static int envInt(const char* name, int fallback) {
+        const char* v = std::getenv(name);
+        if(!v || !*v) return fallback;
+        char* end = nullptr;
+        long n = std::strtol(v, &end, 10);
+        return *end == '\0' ? static_cast<int>(n) : fallback;
+    }
+};
+
+// Pins the calling thread to one CPU. Returns 0 or the error number.
+inline int pinThisThread(int cpu) {
+    if(cpu < 0 || cpu >= CPU_SETSIZE) return EINVAL;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+// Moves the calling thread to SCHED_FIFO at the given priority. Returns 0 or the error
+// number (EPERM without CAP_SYS_NICE or an RLIMIT_RTPRIO allowance).
+inline int setRealtimePriority(int priority) {
+    sched_param param{};
+    param.sched_priority = priority;
+    return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+}
@@ -0,0 +1,143 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <ostream>
+
+#include "decimal.hpp"
+
+// Strongly typed fixed-point price and money.
+// Price and Money carry PRICE_DECIMALS (4) implied decimals in an int64, matching the
+// precision Alpha Vantage quotes in, so quote math, rounding to the tick grid and portfolio
+// accounting are exact integer operations. Plain 8-byte structs, so std::atomic<Price>
+// and std::atomic<Money> are lock-free loads and stores.
+
+struct TickSize {
+    int64_t ticks = 100;
+};
+
+constexpr TickSize PENNY{100};    // $0.01
+constexpr TickSize SUB_PENNY{1};  // $0.0001
+
+struct Price {
+    int64_t ticks = 0;
+
+    constexpr bool positive() const { return ticks > 0; }
+
+    constexpr Price operator+(Price o) const { return Price{ticks + o.ticks}; }
+    constexpr Price operator-(Price o) const { return Price{ticks - o.ticks}; }
+    constexpr bool operator==(Price o) const { return ticks == o.ticks; }
+    constexpr bool operator!=(Price o) const { return ticks != o.ticks; }
+    constexpr bool operator<(Price o) const { return ticks < o.ticks; }
+    constexpr bool operator<=(Price o) const { return ticks <= o.ticks; }
+    constexpr bool operator>(Price o) const { return ticks > o.ticks; }
+    constexpr bool operator>=(Price o) const { return ticks >= o.ticks; }
+};
+
+struct Money {
+    int64_t units = 0;  // 10^-PRICE_DECIMALS dollars
+
+    static constexpr Money dollars(int64_t d) { return Money{d * PRICE_SCALE}; }
+
+    constexpr Money operator+(Money o) const { return Money{units + o.units}; }
+    constexpr Money operator-(Money o) const { return Money{units - o.units}; }
+    constexpr Money& operator+=(Money o) { units += o.units; return *this; }
+    constexpr Money& operator-=(Money o) { units -= o.units; return *this; }
+    constexpr bool operator==(Money o) const { return units == o.units; }
+    constexpr bool operator!=(Money o) const { return units != o.units; }
+    constexpr bool operator<(Money o) const { return units < o.units; }
+};
+
+// Spread in hundredths of a basis point, so 5.25 bps is exact.
+struct SpreadBps {
+    int64_t centi_bps = 500;
+
+    static SpreadBps fromBps(double bps) { return SpreadBps{std::llround(bps * 100.0)}; }
+};
+
+// Price * quantity, exact.
+constexpr Money notional(Price p, int64_t qty) { return Money{p.ticks * qty}; }
+
+constexpr Price floorToTick(Price p, TickSize t) {
+    int64_t q = p.ticks / t.ticks;
+    if(p.ticks % t.ticks != 0 && p.ticks < 0) --q;
+    return Price{q * t.ticks};
+}
+
+constexpr Price ceilToTick(Price p, TickSize t) {
+    int64_t q = p.ticks / t.ticks;
+    if(p.ticks % t.ticks != 0 && p.ticks > 0) ++q;
+    return Price{q * t.ticks};
+}
+
+// mid * bps / 10000, truncated to whole ticks. Falls back to 128 bits only if the product
+// overflows, so the common case divides by a constant (a multiply) rather than calling __divti3.
+constexpr Price spreadOffset(Price mid, SpreadBps spread) {
+    int64_t product = 0;
+    if(!__builtin_mul_overflow(mid.ticks, spread.centi_bps, &product)) return Price{product / 1'000'000};
+    return Price{static_cast<int64_t>(static_cast<__int128>(mid.ticks) * spread.centi_bps / 1'000'000)};
+}
+
+struct QuotePair {
+    Price bid;
+    Price ask;
+};
+
+// Our bid/ask either side of mid, rounded outwards onto the tick grid so the quoted
+// spread is never narrower than requested.
+constexpr QuotePair quoteAround(Price mid, SpreadBps spread, TickSize tick) {
+    Price offset = spreadOffset(mid, spread);
+    return QuotePair{floorToTick(mid - offset, tick), ceilToTick(mid + offset, tick)};
+}
+
+// US equities (Reg NMS rule 612): pennies at $1.00 and above, $0.0001 below.
+constexpr TickSize defaultTickSize(Price p) {
+    return p.ticks >= PRICE_SCALE ? PENNY : SUB_PENNY;
+}
+
+namespace fixed_point_detail {
+    // Writes value * 10^-scale. With std::fixed the stream precision picks the number of
+    // decimals (capped at scale, rounded half away from zero); otherwise all scale decimals.
+    inline std::ostream& writeScaled(std::ostream& os, int64_t value, int scale) {
+        int decimals = scale;
+        if(os.flags() & std::ios::fixed) {
+            decimals = static_cast<int>(std::min<std::streamsize>(std::max<std::streamsize>(os.precision(), 0), scale));
+        }
+        int64_t div = 1;
+        for(int i = decimals; i < scale; ++i) div *= 10;
+        uint64_t mag = value < 0 ? static_cast<uint64_t>(-(value + 1)) + 1 : static_cast<uint64_t>(value);
+        mag = (mag + static_cast<uint64_t>(div) / 2) / static_cast<uint64_t>(div);
+
+        uint64_t unit = 1;
+        for(int i = 0; i < decimals; ++i) unit *= 10;
+
+        char buf[32];
+        char* p = buf + sizeof(buf);
+        *--p = '\0';
+        uint64_t frac = mag % unit;
+        for(int i = 0; i < decimals; ++i) {
+            *--p = static_cast<char>('0' + frac % 10);
+            frac /= 10;
+        }
+        if(decimals > 0) *--p = '.';
+        uint64_t whole = mag / unit;
+        do {
+            *--p = static_cast<char>('0' + whole % 10);
+            whole /= 10;
+        } while(whole);
+        if(value < 0 && mag != 0) *--p = '-';
+        return os << p;
+    }
+}
+
+inline std::ostream& operator<<(std::ostream& os, Price p) {
+    return fixed_point_detail::writeScaled(os, p.ticks, PRICE_DECIMALS);
+}
+
+inline std::ostream& operator<<(std::ostream& os, Money m) {
+    return fixed_point_detail::writeScaled(os, m.units, PRICE_DECIMALS);
+}
+
+inline std::ostream& operator<<(std::ostream& os, SpreadBps s) {
+    return fixed_point_detail::writeScaled(os, s.centi_bps, 2);
+}
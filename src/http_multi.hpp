@@ -0,0 +1,122 @@
+#pragma once
+#include <curl/curl.h>
+#include <functional>
+#include <string>
+
+#include "async_timers.hpp"
+#include "reactor.hpp"
+
+// Non-blocking HTTP on the reactor through libcurl's multi-socket interface: curl tells
+// us which sockets to watch and when its next timeout is due, the reactor reports
+// readiness, and completed transfers are handed back through their done callback. Any
+// number of transfers can be in flight on the one reactor thread. curl's timeouts are
+// scheduled on the reactor's AsyncTimers wheel alongside every other timer event.
+
+// One reusable transfer. The easy handle (and with it the connection cache entry) lives
+// as long as the request, so repeated polls reuse the connection.
+struct HttpRequest {
+    using Done = std::function<void(CURLcode)>;
+
+    HttpRequest() : easy(curl_easy_init()) {}
+    HttpRequest(const HttpRequest&) = delete;
+    HttpRequest& operator=(const HttpRequest&) = delete;
+    ~HttpRequest() { if(easy) curl_easy_cleanup(easy); }
+
+    CURL* easy;
+    Done done;
+    bool in_flight = false;
+};
+
+class HttpMulti : private TimerNode {
+public:
+    HttpMulti(Reactor& r, AsyncTimers& t) : TimerNode(onTimeout), reactor(r), timers(t), multi(curl_multi_init()) {
+        curl_multi_setopt(multi, CURLMOPT_SOCKETFUNCTION, onSocket);
+        curl_multi_setopt(multi, CURLMOPT_SOCKETDATA, this);
+        curl_multi_setopt(multi, CURLMOPT_TIMERFUNCTION, onTimer);
+        curl_multi_setopt(multi, CURLMOPT_TIMERDATA, this);
+    }
+    HttpMulti(const HttpMulti&) = delete;
+    HttpMulti& operator=(const HttpMulti&) = delete;
+    ~HttpMulti() {
+        timers.cancel(*this);
+        curl_multi_cleanup(multi);
+    }
+
+    // Starts a GET of url; body chunks go to write(userdata). done runs on the reactor
+    // thread when the transfer finishes or fails. False if the request is already running.
+    bool get(HttpRequest& req, const std::string& url, curl_write_callback write, void* userdata, HttpRequest::Done done,
+             long timeout_s = 10) {
+        if(!req.easy || req.in_flight) return false;
+        curl_easy_setopt(req.easy, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(req.easy, CURLOPT_WRITEFUNCTION, write);
+        curl_easy_setopt(req.easy, CURLOPT_WRITEDATA, userdata);
+        curl_easy_setopt(req.easy, CURLOPT_TIMEOUT, timeout_s);
+        curl_easy_setopt(req.easy, CURLOPT_SSL_VERIFYPEER, 1L);
+        curl_easy_setopt(req.easy, CURLOPT_PRIVATE, &req);
+        req.done = std::move(done);
+        req.in_flight = curl_multi_add_handle(multi, req.easy) == CURLM_OK;
+        return req.in_flight;
+    }
+
+    // Abandons a running transfer without calling its done callback.
+    void cancel(HttpRequest& req) {
+        if(!req.in_flight) return;
+        curl_multi_remove_handle(multi, req.easy);
+        req.in_flight = false;
+    }
+
+private:
+    static int onSocket(CURL*, curl_socket_t s, int what, void* userp, void*) {
+        HttpMulti* self = static_cast<HttpMulti*>(userp);
+        if(what == CURL_POLL_REMOVE) {
+            self->reactor.remove(s);
+            return 0;
+        }
+        uint32_t events = (what & CURL_POLL_IN ? EPOLLIN : 0) | (what & CURL_POLL_OUT ? EPOLLOUT : 0);
+        if(!self->reactor.modify(s, events)) {
+            self->reactor.add(s, events, [self, s](uint32_t ev) {
+                int flags = (ev & EPOLLIN ? CURL_CSELECT_IN : 0) | (ev & EPOLLOUT ? CURL_CSELECT_OUT : 0) |
+                            (ev & (EPOLLERR | EPOLLHUP) ? CURL_CSELECT_ERR : 0);
+                int running = 0;
+                curl_multi_socket_action(self->multi, s, flags, &running);
+                self->collect();
+            });
+        }
+        return 0;
+    }
+
+    // curl must not be re-entered from here, so due-now timeouts go through the wheel too.
+    static int onTimer(CURLM*, long timeout_ms, void* userp) {
+        HttpMulti* self = static_cast<HttpMulti*>(userp);
+        if(timeout_ms < 0) self->timers.cancel(*self);
+        else self->timers.schedule(*self, AsyncTimers::Clock::now() + std::chrono::milliseconds(timeout_ms));
+        return 0;
+    }
+
+    static void onTimeout(TimerNode* n) {
+        HttpMulti* self = static_cast<HttpMulti*>(n);
+        int running = 0;
+        curl_multi_socket_action(self->multi, CURL_SOCKET_TIMEOUT, 0, &running);
+        self->collect();
+    }
+
+    void collect() {
+        int left = 0;
+        while(CURLMsg* msg = curl_multi_info_read(multi, &left)) {
+            if(msg->msg != CURLMSG_DONE) continue;
+            HttpRequest* req = nullptr;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &req);
+            CURLcode result = msg->data.result;
+            curl_multi_remove_handle(multi, msg->easy_handle);
+            if(!req) continue;
+            req->in_flight = false;
+            // Moved out so done may start the next transfer on the same request
+            HttpRequest::Done done = std::move(req->done);
+            if(done) done(result);
+        }
+    }
+
+    Reactor& reactor;
+    AsyncTimers& timers;
+    CURLM* multi;
+};
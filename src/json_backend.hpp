@@ -0,0 +1,528 @@
+#pragma once
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <json/json.h>
+
+#include "json_scan.hpp"
+#include "market_data.hpp"
+#include "quote_parser.hpp"
+
+// Pluggable JSON decoding for the Alpha Vantage endpoints we consume:
+//   GLOBAL_QUOTE          -> one QuoteRecord
+//   REALTIME_BULK_QUOTES  -> one QuoteRecord per element of "data"
+//   TIME_SERIES_INTRADAY  -> one Bar per timestamp of "Time Series (...)"
+// Three interchangeable backends:
+//   scanner   hand-rolled fixed-schema walk over the structural cursor
+//   jsoncpp   full DOM via jsoncpp
+//   ondemand  generic lazy reader over the structural cursor; keys are matched by name and
+//             unwanted subtrees are skipped without being materialized
+// The default is fixed at build time (-DHFT_JSON_BACKEND=...) and can be overridden at run
+// time with the HFT_JSON_BACKEND environment variable.
+
+#ifndef HFT_DEFAULT_JSON_BACKEND
+#define HFT_DEFAULT_JSON_BACKEND "scanner"
+#endif
+
+enum class JsonBackendKind : uint8_t { Scanner, JsonCpp, OnDemand };
+
+class JsonBackend {
+public:
+    virtual ~JsonBackend() = default;
+    virtual const char* name() const = 0;
+    // False when the body carries no quote (API error or rate limit note) or is malformed.
+    virtual bool parseGlobalQuote(std::string_view body, QuoteRecord& out) = 0;
+    // Appends one record per bulk quote element; returns how many were appended.
+    virtual size_t parseBulkQuotes(std::string_view body, std::vector<QuoteRecord>& out) = 0;
+    // Appends one bar per intraday timestamp, in response order; returns how many were appended.
+    virtual size_t parseIntraday(std::string_view body, std::vector<Bar>& out) = 0;
+
+    // After parseGlobalQuote: whether "05. price" was there but failed to parse (as opposed
+    // to missing), and its text.
+    bool priceUnparsed() const { return price_unparsed; }
+    const std::string& unparsedPrice() const { return price_text; }
+
+protected:
+    void clearPriceIssue() { price_unparsed = false; }
+    void notePriceIssue(std::string_view text) {
+        price_unparsed = true;
+        price_text.assign(text);
+    }
+
+private:
+    bool price_unparsed = false;
+    std::string price_text;
+};
+
+namespace json_backend_detail {
+    inline std::string_view trim(const char* begin, const char* end) {
+        while(begin < end && (*begin == ' ' || *begin == '\n' || *begin == '\r' || *begin == '\t')) ++begin;
+        while(end > begin && (end[-1] == ' ' || end[-1] == '\n' || end[-1] == '\r' || end[-1] == '\t')) --end;
+        return std::string_view(begin, static_cast<size_t>(end - begin));
+    }
+
+    // Reads "key": value with the cursor sitting just past the key's opening quote.
+    // value is a string body or a trimmed literal (number, null). after is the token that
+    // follows the value (',' or '}'), or end on malformed input.
+    inline bool readPair(StructuralCursor& cur, const char* keyStart, std::string_view& key,
+                         std::string_view& value, const char*& after) {
+        const char* end = cur.end();
+        const char* keyEnd = cur.stringEnd();
+        if(keyEnd == end) return false;
+        key = std::string_view(keyStart, static_cast<size_t>(keyEnd - keyStart));
+
+        const char* colon = cur.next();
+        if(colon == end || *colon != ':') return false;
+        const char* p = cur.next();
+        if(p == end) return false;
+        if(*p == '"') {
+            const char* valueEnd = cur.stringEnd();
+            if(valueEnd == end) return false;
+            value = std::string_view(p + 1, static_cast<size_t>(valueEnd - p - 1));
+            after = cur.next();
+        } else {
+            value = trim(colon + 1, p);
+            after = p;
+        }
+        return after != end;
+    }
+
+    // Fixed-schema key dispatch for bulk quote elements: (first char, length) is unique per key.
+    inline bool bulkKeyFast(std::string_view key, QuoteField& out) {
+        if(key.empty()) return false;
+        switch(key[0]) {
+            case 's': if(key.size() == 6) { out = QuoteField::Symbol; return true; } break;
+            case 't': if(key.size() == 9) { out = QuoteField::LatestTradingDay; return true; } break;
+            case 'o': if(key.size() == 4) { out = QuoteField::Open; return true; } break;
+            case 'h': if(key.size() == 4) { out = QuoteField::High; return true; } break;
+            case 'l': if(key.size() == 3) { out = QuoteField::Low; return true; } break;
+            case 'v': if(key.size() == 6) { out = QuoteField::Volume; return true; } break;
+            case 'p': if(key.size() == 14) { out = QuoteField::PreviousClose; return true; } break;
+            case 'c':
+                if(key.size() == 5) { out = QuoteField::Price; return true; }
+                if(key.size() == 6) { out = QuoteField::Change; return true; }
+                if(key.size() == 14) { out = QuoteField::ChangePercent; return true; }
+                break;
+        }
+        return false;
+    }
+
+    // Fields of one bulk quote element, cursor just past its '{'. Consumes the closing '}'.
+    inline bool readBulkRecord(StructuralCursor& cur, QuoteRecord& rec) {
+        const char* after = nullptr;
+        do {
+            const char* p = cur.next();
+            if(p == cur.end()) return false;
+            if(*p == '}') return true;
+            if(*p != '"') return false;
+            std::string_view key, value;
+            if(!readPair(cur, p + 1, key, value, after)) return false;
+            QuoteField field;
+            if(bulkKeyFast(key, field)) applyQuoteField(rec, field, value);
+        } while(*after == ',');
+        return *after == '}';
+    }
+
+    // One intraday entry "2024-10-04 19:55:00": { "1. open": "...", ... } with the cursor just
+    // past the timestamp's opening quote (keyStart). Bar fields are slotted by numeric prefix.
+    inline bool readBarEntry(StructuralCursor& cur, const char* keyStart, Bar& bar) {
+        const char* end = cur.end();
+        const char* keyEnd = cur.stringEnd();
+        if(keyEnd == end || !parseDateTime(std::string_view(keyStart, static_cast<size_t>(keyEnd - keyStart)), bar.time)) {
+            return false;
+        }
+        const char* p = cur.next();
+        if(p == end || *p != ':') return false;
+        p = cur.next();
+        if(p == end || *p != '{') return false;
+
+        const char* after = nullptr;
+        do {
+            p = cur.next();
+            if(p == end) return false;
+            if(*p == '}') return true;
+            if(*p != '"') return false;
+            std::string_view key, value;
+            if(!readPair(cur, p + 1, key, value, after)) return false;
+            unsigned idx = static_cast<unsigned>(key.empty() ? 0xff : key[0] - '1');
+            if(idx < static_cast<unsigned>(BarField::Count)) applyBarField(bar, static_cast<BarField>(idx), value);
+        } while(*after == ',');
+        return *after == '}';
+    }
+}
+
+// Hand-rolled fixed-schema decoder. Assumes Alpha Vantage's key naming (numeric prefixes,
+// bulk key shapes) and only visits structural characters.
+class ScannerJsonBackend : public JsonBackend {
+public:
+    explicit ScannerJsonBackend(const JsonScanner& scanner = jsonScanner()) : scan(scanner) {}
+
+    const char* name() const override { return "scanner"; }
+
+    bool parseGlobalQuote(std::string_view body, QuoteRecord& out) override {
+        clearPriceIssue();
+        GlobalQuote quote;
+        if(!::parseGlobalQuote(body, quote, scan)) return false;
+        out = toQuoteRecord(quote);
+        if(quote.has(QuoteField::Price) && !out.has(QuoteField::Price)) notePriceIssue(quote[QuoteField::Price]);
+        return out.has(QuoteField::Price);
+    }
+
+    size_t parseBulkQuotes(std::string_view body, std::vector<QuoteRecord>& out) override {
+        using namespace json_backend_detail;
+        size_t pos = body.find("\"data\"");
+        if(pos == std::string_view::npos) return 0;
+
+        const char* end = body.data() + body.size();
+        StructuralCursor cur(body.data() + pos + 6, end, scan);
+        const char* p = cur.next();
+        if(p == end || *p != ':') return 0;
+        p = cur.next();
+        if(p == end || *p != '[') return 0;
+
+        size_t count = 0;
+        for(;;) {
+            p = cur.next();
+            if(p == end || *p == ']') return count;
+            if(*p == ',') continue;
+            if(*p != '{') return count;
+
+            QuoteRecord rec;
+            if(!readBulkRecord(cur, rec)) return count;
+            out.push_back(rec);
+            ++count;
+        }
+    }
+
+    size_t parseIntraday(std::string_view body, std::vector<Bar>& out) override {
+        using namespace json_backend_detail;
+        size_t pos = body.find("\"Time Series");
+        if(pos == std::string_view::npos) return 0;
+
+        const char* end = body.data() + body.size();
+        StructuralCursor cur(body.data() + pos + 1, end, scan);
+        const char* p = cur.stringEnd();
+        if(p == end) return 0;
+        p = cur.next();
+        if(p == end || *p != ':') return 0;
+        p = cur.next();
+        if(p == end || *p != '{') return 0;
+
+        size_t count = 0;
+        for(;;) {
+            p = cur.next();
+            if(p == end || *p == '}') return count;
+            if(*p == ',') continue;
+            if(*p != '"') return count;
+
+            Bar bar;
+            if(!readBarEntry(cur, p + 1, bar)) return count;
+            out.push_back(bar);
+            ++count;
+        }
+    }
+
+private:
+    const JsonScanner& scan;
+};
+
+// Full DOM parse through jsoncpp.
+class JsonCppBackend : public JsonBackend {
+public:
+    JsonCppBackend() {
+        Json::CharReaderBuilder builder;
+        reader.reset(builder.newCharReader());
+    }
+
+    const char* name() const override { return "jsoncpp"; }
+
+    bool parseGlobalQuote(std::string_view body, QuoteRecord& out) override {
+        clearPriceIssue();
+        if(!parse(body)) return false;
+        const Json::Value& quote = root["Global Quote"];
+        if(!quote.isObject()) return false;
+        out = QuoteRecord{};
+        for(auto it = quote.begin(); it != quote.end(); ++it) {
+            QuoteField field;
+            if(!globalQuoteField(it.name(), field)) continue;
+            bool ok = textual(*it) && applyQuoteField(out, field, it->asString());
+            if(!ok && field == QuoteField::Price) notePriceIssue(textual(*it) ? it->asString() : it->toStyledString());
+        }
+        return out.has(QuoteField::Price);
+    }
+
+    size_t parseBulkQuotes(std::string_view body, std::vector<QuoteRecord>& out) override {
+        if(!parse(body)) return 0;
+        const Json::Value& data = root["data"];
+        if(!data.isArray()) return 0;
+        size_t count = 0;
+        for(const Json::Value& item : data) {
+            if(!item.isObject()) continue;
+            QuoteRecord rec;
+            for(auto it = item.begin(); it != item.end(); ++it) {
+                QuoteField field;
+                if(textual(*it) && bulkQuoteField(it.name(), field)) applyQuoteField(rec, field, it->asString());
+            }
+            out.push_back(rec);
+            ++count;
+        }
+        return count;
+    }
+
+    size_t parseIntraday(std::string_view body, std::vector<Bar>& out) override {
+        if(!parse(body)) return 0;
+        size_t count = 0;
+        for(auto series = root.begin(); series != root.end(); ++series) {
+            if(series.name().rfind("Time Series", 0) != 0 || !series->isObject()) continue;
+            for(auto entry = series->begin(); entry != series->end(); ++entry) {
+                Bar bar;
+                if(!parseDateTime(entry.name(), bar.time) || !entry->isObject()) continue;
+                for(auto it = entry->begin(); it != entry->end(); ++it) {
+                    BarField field;
+                    if(textual(*it) && barField(it.name(), field)) applyBarField(bar, field, it->asString());
+                }
+                out.push_back(bar);
+                ++count;
+            }
+        }
+        // jsoncpp keeps object members sorted by key; restore response (newest first) order
+        std::reverse(out.end() - static_cast<std::ptrdiff_t>(count), out.end());
+        return count;
+    }
+
+private:
+    // Strings, plus bare integers (a volume sent as a number), which the other backends read
+    // as raw text too. Fractional literals are skipped: jsoncpp keeps the double, not its digits.
+    static bool textual(const Json::Value& v) {
+        return v.isString() || v.type() == Json::intValue || v.type() == Json::uintValue;
+    }
+
+    bool parse(std::string_view body) {
+        root = Json::Value();
+        return reader->parse(body.data(), body.data() + body.size(), &root, nullptr);
+    }
+
+    std::unique_ptr<Json::CharReader> reader;
+    Json::Value root;
+};
+
+// Generic pull reader over the structural cursor. Understands objects, arrays of
+// objects/strings, strings and bare literals; skips whatever the caller does not ask for.
+class OnDemandReader {
+public:
+    OnDemandReader(std::string_view body, const JsonScanner& scanner)
+        : cur(body.data(), body.data() + body.size(), scanner), last(body.data()) {}
+
+    bool ok() const { return !failed; }
+
+    bool enterObject() { return expect('{'); }
+    bool enterArray() { return expect('['); }
+
+    // Advances to the next field of the current object and consumes its ':'.
+    // False at the closing '}' (consumed) or on error.
+    bool nextField(std::string_view& key) {
+        const char* t = take();
+        if(t != cur.end() && *t == ',') t = take();
+        if(t == cur.end() || *t != '"') { failed = failed || t == cur.end() || *t != '}'; return false; }
+        const char* keyEnd = cur.stringEnd();
+        if(keyEnd == cur.end()) { failed = true; return false; }
+        key = std::string_view(t + 1, static_cast<size_t>(keyEnd - t - 1));
+        last = keyEnd;
+        return expect(':');
+    }
+
+    // Advances to the next element of the current array. False at the closing ']'.
+    bool nextElement() {
+        const char* t = take();
+        if(t != cur.end() && *t == ',') t = take();
+        if(t == cur.end() || *t == ']') { failed = failed || t == cur.end(); return false; }
+        pending = t;
+        return true;
+    }
+
+    // String body or trimmed literal of the current value. False for an object or array
+    // value, which is left in place for skipValue().
+    bool value(std::string_view& out) {
+        const char* prev = last;           // the ':' or '[' / ',' before the value; take() moves last to t
+        const char* t = take();
+        if(t == cur.end()) { failed = true; return false; }
+        if(*t == '"') {
+            const char* e = cur.stringEnd();
+            if(e == cur.end()) { failed = true; return false; }
+            out = std::string_view(t + 1, static_cast<size_t>(e - t - 1));
+            last = e;
+            return true;
+        }
+        if(*t == '{' || *t == '[') { pending = t; return false; }
+        out = json_backend_detail::trim(prev + 1, t);
+        pending = t;
+        return true;
+    }
+
+    // Skips the current value, including nested objects and arrays.
+    bool skipValue() {
+        const char* t = take();
+        if(t == cur.end()) { failed = true; return false; }
+        if(*t == '"') {
+            last = cur.stringEnd();
+            if(last == cur.end()) { failed = true; return false; }
+            return true;
+        }
+        if(*t != '{' && *t != '[') { pending = t; return true; }
+        int depth = 1;
+        while(depth > 0) {
+            t = take();
+            if(t == cur.end()) { failed = true; return false; }
+            if(*t == '"') {
+                if(cur.stringEnd() == cur.end()) { failed = true; return false; }
+            } else if(*t == '{' || *t == '[') {
+                ++depth;
+            } else if(*t == '}' || *t == ']') {
+                --depth;
+            }
+        }
+        return true;
+    }
+
+private:
+    const char* take() {
+        if(pending) {
+            const char* t = pending;
+            pending = nullptr;
+            return t;
+        }
+        const char* t = cur.next();
+        if(t != cur.end()) last = t;
+        return t;
+    }
+
+    bool expect(char c) {
+        const char* t = take();
+        if(t == cur.end() || *t != c) { failed = true; return false; }
+        return true;
+    }
+
+    StructuralCursor cur;
+    const char* last;
+    const char* pending = nullptr;
+    bool failed = false;
+};
+
+class OnDemandJsonBackend : public JsonBackend {
+public:
+    explicit OnDemandJsonBackend(const JsonScanner& scanner = jsonScanner()) : scan(scanner) {}
+
+    const char* name() const override { return "ondemand"; }
+
+    bool parseGlobalQuote(std::string_view body, QuoteRecord& out) override {
+        clearPriceIssue();
+        OnDemandReader r(body, scan);
+        std::string_view key, value;
+        out = QuoteRecord{};
+        if(!r.enterObject()) return false;
+        while(r.nextField(key)) {
+            if(key != "Global Quote") { r.skipValue(); continue; }
+            if(!r.enterObject()) return false;
+            while(r.nextField(key)) {
+                QuoteField field;
+                if(!globalQuoteField(key, field) || !r.value(value)) {
+                    r.skipValue();
+                    continue;
+                }
+                if(!applyQuoteField(out, field, value) && field == QuoteField::Price) notePriceIssue(value);
+            }
+            return r.ok() && out.has(QuoteField::Price);
+        }
+        return false;
+    }
+
+    size_t parseBulkQuotes(std::string_view body, std::vector<QuoteRecord>& out) override {
+        OnDemandReader r(body, scan);
+        std::string_view key, value;
+        size_t count = 0;
+        if(!r.enterObject()) return 0;
+        while(r.nextField(key)) {
+            if(key != "data") { r.skipValue(); continue; }
+            if(!r.enterArray()) return count;
+            while(r.nextElement()) {
+                if(!r.enterObject()) return count;
+                QuoteRecord rec;
+                while(r.nextField(key)) {
+                    QuoteField field;
+                    if(bulkQuoteField(key, field) && r.value(value)) applyQuoteField(rec, field, value);
+                    else r.skipValue();
+                }
+                if(!r.ok()) return count;
+                out.push_back(rec);
+                ++count;
+            }
+            return count;
+        }
+        return count;
+    }
+
+    size_t parseIntraday(std::string_view body, std::vector<Bar>& out) override {
+        OnDemandReader r(body, scan);
+        std::string_view key, value;
+        size_t count = 0;
+        if(!r.enterObject()) return 0;
+        while(r.nextField(key)) {
+            if(key.substr(0, 11) != "Time Series") { r.skipValue(); continue; }
+            if(!r.enterObject()) return count;
+            while(r.nextField(key)) {
+                Bar bar;
+                if(!parseDateTime(key, bar.time) || !r.enterObject()) return count;
+                while(r.nextField(key)) {
+                    BarField field;
+                    if(barField(key, field) && r.value(value)) applyBarField(bar, field, value);
+                    else r.skipValue();
+                }
+                if(!r.ok()) return count;
+                out.push_back(bar);
+                ++count;
+            }
+            return count;
+        }
+        return count;
+    }
+
+private:
+    const JsonScanner& scan;
+};
+
+inline const char* toString(JsonBackendKind kind) {
+    switch(kind) {
+        case JsonBackendKind::Scanner: return "scanner";
+        case JsonBackendKind::JsonCpp: return "jsoncpp";
+        case JsonBackendKind::OnDemand: return "ondemand";
+    }
+    return "unknown";
+}
+
+inline bool parseJsonBackendKind(std::string_view text, JsonBackendKind& out) {
+    for(JsonBackendKind kind : {JsonBackendKind::Scanner, JsonBackendKind::JsonCpp, JsonBackendKind::OnDemand}) {
+        if(text == toString(kind)) { out = kind; return true; }
+    }
+    return false;
+}
+
+// HFT_JSON_BACKEND from the environment if set and valid, otherwise the build default.
+inline JsonBackendKind defaultJsonBackend() {
+    JsonBackendKind kind = JsonBackendKind::Scanner;
+    const char* env = std::getenv("HFT_JSON_BACKEND");
+    if(env && parseJsonBackendKind(env, kind)) return kind;
+    parseJsonBackendKind(HFT_DEFAULT_JSON_BACKEND, kind);
+    return kind;
+}
+
+inline std::unique_ptr<JsonBackend> makeJsonBackend(JsonBackendKind kind) {
+    switch(kind) {
+        case JsonBackendKind::JsonCpp: return std::make_unique<JsonCppBackend>();
+        case JsonBackendKind::OnDemand: return std::make_unique<OnDemandJsonBackend>();
+        case JsonBackendKind::Scanner: break;
+    }
+    return std::make_unique<ScannerJsonBackend>();
+}
@@ -0,0 +1,172 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <immintrin.h>
+
+// Structural-character scanner for JSON market data.
+// Locating quotes, colons, commas and braces is the bulk of the work when decoding
+// Alpha Vantage responses, so the input is classified 64 bytes at a time into a bitmask
+// of structural positions and tokens are then popped off the mask one bit at a time.
+// The classification kernel is chosen once at startup (runtime CPU dispatch);
+// HFT_SIMD=scalar|sse42|avx2 forces a specific one.
+
+enum class ScanIsa : uint8_t { Scalar, Sse42, Avx2 };
+
+struct JsonScanner {
+    ScanIsa isa;
+    const char* name;
+    // Bit i set when p[i] is one of " : , { } [ ] or backslash; n <= 64.
+    uint64_t (*structuralMask)(const char* p, size_t n);
+};
+
+namespace json_scan_detail {
+    struct StructuralTable {
+        bool structural[256] = {};
+        constexpr StructuralTable() {
+            for(unsigned char c : {'"', ':', ',', '{', '}', '[', ']', '\\'}) structural[c] = true;
+        }
+    };
+    inline constexpr StructuralTable TABLE{};
+
+    inline uint64_t maskScalar(const char* p, size_t n) {
+        uint64_t mask = 0;
+        for(size_t i = 0; i < n; ++i) {
+            mask |= static_cast<uint64_t>(TABLE.structural[static_cast<unsigned char>(p[i])]) << i;
+        }
+        return mask;
+    }
+
+    __attribute__((target("sse4.2")))
+    inline uint64_t maskSse42(const char* p, size_t n) {
+        if(n < 64) return maskScalar(p, n);
+        const __m128i set = _mm_setr_epi8('"', ':', ',', '{', '}', '[', ']', '\\', 0, 0, 0, 0, 0, 0, 0, 0);
+        constexpr int mode = _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_BIT_MASK;
+        uint64_t mask = 0;
+        for(int i = 0; i < 4; ++i) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * i));
+            uint64_t bits = static_cast<uint16_t>(_mm_cvtsi128_si32(_mm_cmpestrm(set, 8, chunk, 16, mode)));
+            mask |= bits << (16 * i);
+        }
+        return mask;
+    }
+
+    __attribute__((target("avx2")))
+    inline uint32_t maskAvx2Half(const char* p) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i m = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(':'))),
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(',')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'))));
+        // { } and [ ] differ only in bit 0x20, so fold them with one OR
+        __m256i folded = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+        m = _mm256_or_si256(m, _mm256_or_si256(_mm256_cmpeq_epi8(folded, _mm256_set1_epi8('{')),
+                                               _mm256_cmpeq_epi8(folded, _mm256_set1_epi8('}'))));
+        return static_cast<uint32_t>(_mm256_movemask_epi8(m));
+    }
+
+    __attribute__((target("avx2")))
+    inline uint64_t maskAvx2(const char* p, size_t n) {
+        if(n < 64) return maskScalar(p, n);
+        return static_cast<uint64_t>(maskAvx2Half(p)) | static_cast<uint64_t>(maskAvx2Half(p + 32)) << 32;
+    }
+
+    inline const JsonScanner SCANNERS[] = {
+        {ScanIsa::Scalar, "scalar", maskScalar},
+        {ScanIsa::Sse42, "sse4.2", maskSse42},
+        {ScanIsa::Avx2, "avx2", maskAvx2},
+    };
+
+    inline const JsonScanner& selectScanner();
+}
+
+inline bool scanIsaSupported(ScanIsa isa) {
+    switch(isa) {
+        case ScanIsa::Scalar: return true;
+        case ScanIsa::Sse42: return __builtin_cpu_supports("sse4.2");
+        case ScanIsa::Avx2: return __builtin_cpu_supports("avx2");
+    }
+    return false;
+}
+
+// A specific kernel, regardless of CPU support (callers check scanIsaSupported first).
+inline const JsonScanner& jsonScanner(ScanIsa isa) {
+    return json_scan_detail::SCANNERS[static_cast<int>(isa)];
+}
+
+// The kernel selected for this CPU. Resolved on first use.
+inline const JsonScanner& jsonScanner() {
+    static const JsonScanner& active = json_scan_detail::selectScanner();
+    return active;
+}
+
+inline const JsonScanner& json_scan_detail::selectScanner() {
+    if(const char* forced = std::getenv("HFT_SIMD")) {
+        for(const JsonScanner& s : SCANNERS) {
+            if(std::strcmp(forced, s.name) == 0 || (s.isa == ScanIsa::Sse42 && std::strcmp(forced, "sse42") == 0)) {
+                if(scanIsaSupported(s.isa)) return s;
+            }
+        }
+    }
+    if(scanIsaSupported(ScanIsa::Avx2)) return SCANNERS[static_cast<int>(ScanIsa::Avx2)];
+    if(scanIsaSupported(ScanIsa::Sse42)) return SCANNERS[static_cast<int>(ScanIsa::Sse42)];
+    return SCANNERS[static_cast<int>(ScanIsa::Scalar)];
+}
+
+// Walks the set bits of a per-64-byte-block classification mask over [begin, end), i.e. the
+// positions of whatever characters maskFn marks. Holds one block's mask at a time, so next()
+// is a ctz and a bit clear except at block boundaries.
+using BlockMaskFn = uint64_t (*)(const char* p, size_t n);
+
+class BlockMaskCursor {
+public:
+    BlockMaskCursor(const char* begin, const char* end, BlockMaskFn maskFn) : classify(maskFn), stop(end) {
+        seek(begin);
+    }
+
+    // Next marked character, or end() when the input is exhausted.
+    const char* next() {
+        while(mask == 0) {
+            block += 64;
+            if(block >= stop) return stop;
+            mask = classify(block, std::min<size_t>(64, static_cast<size_t>(stop - block)));
+        }
+        const char* p = block + __builtin_ctzll(mask);
+        mask &= mask - 1;
+        return p;
+    }
+
+    // Restart scanning at p.
+    void seek(const char* p) {
+        block = p;
+        mask = p < stop ? classify(p, std::min<size_t>(64, static_cast<size_t>(stop - p))) : 0;
+    }
+
+    const char* end() const { return stop; }
+
+private:
+    BlockMaskFn classify;
+    const char* stop;
+    const char* block = nullptr;
+    uint64_t mask = 0;
+};
+
+// Walks the JSON structural characters of [begin, end) in order.
+class StructuralCursor : public BlockMaskCursor {
+public:
+    StructuralCursor(const char* begin, const char* end, const JsonScanner& scanner = jsonScanner())
+        : BlockMaskCursor(begin, end, scanner.structuralMask) {}
+
+    // Closing quote of the string whose opening quote was the last token, stepping over
+    // escape sequences and any : , { } inside the string body. end() if unterminated.
+    const char* stringEnd() {
+        for(;;) {
+            const char* p = next();
+            if(p == end() || *p == '"') return p;
+            if(*p == '\\') {
+                if(p + 2 >= end()) return end();
+                seek(p + 2);
+            }
+        }
+    }
+};
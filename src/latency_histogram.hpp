@@ -0,0 +1,65 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+
+// Fixed-size log-linear latency histogram (nanoseconds). Each power of two is split into
+// SUB_BUCKETS linear steps, so any recorded value is reported within 1/SUB_BUCKETS (12.5%)
+// of itself, with no allocation and a constant-time record(). Single writer.
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BITS = 3;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BITS;
+    static constexpr int BUCKETS = (64 - SUB_BITS + 1) * SUB_BUCKETS;
+
+    void record(int64_t ns) {
+        uint64_t v = ns > 0 ? static_cast<uint64_t>(ns) : 0;
+        ++counts[index(v)];
+        ++total;
+        if(v > peak) peak = v;
+    }
+
+    uint64_t count() const { return total; }
+    int64_t max() const { return static_cast<int64_t>(peak); }
+
+    // Upper bound of the bucket holding the p-th fraction of samples (p in [0, 1]).
+    int64_t percentile(double p) const {
+        if(total == 0) return 0;
+        uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(p * static_cast<double>(total) + 0.5));
+        uint64_t seen = 0;
+        for(int i = 0; i < BUCKETS; ++i) {
+            seen += counts[i];
+            if(seen >= rank) return static_cast<int64_t>(std::min(upperBound(i), peak));
+        }
+        return static_cast<int64_t>(peak);
+    }
+
+    void reset() { *this = LatencyHistogram{}; }
+
+    // Adds other's samples (e.g. to report several per-thread histograms together).
+    void merge(const LatencyHistogram& other) {
+        for(int i = 0; i < BUCKETS; ++i) counts[i] += other.counts[i];
+        total += other.total;
+        peak = std::max(peak, other.peak);
+    }
+
+private:
+    // Values below SUB_BUCKETS map one to one; above, by exponent and the next SUB_BITS bits.
+    static int index(uint64_t v) {
+        if(v < SUB_BUCKETS) return static_cast<int>(v);
+        int exp = 63 - __builtin_clzll(v);
+        int sub = static_cast<int>((v >> (exp - SUB_BITS)) & (SUB_BUCKETS - 1));
+        return (exp - SUB_BITS + 1) * SUB_BUCKETS + sub;
+    }
+
+    static uint64_t upperBound(int i) {
+        if(i < SUB_BUCKETS) return static_cast<uint64_t>(i);
+        int exp = i / SUB_BUCKETS + SUB_BITS - 1;
+        uint64_t sub = static_cast<uint64_t>(i % SUB_BUCKETS);
+        uint64_t base = (uint64_t{1} << exp) | (sub << (exp - SUB_BITS));
+        return base + (uint64_t{1} << (exp - SUB_BITS)) - 1;
+    }
+
+    uint64_t counts[BUCKETS] = {};
+    uint64_t total = 0;
+    uint64_t peak = 0;
+};
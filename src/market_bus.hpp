@@ -0,0 +1,469 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "aligned.hpp"
+#include "market_tick.hpp"
+#include "shared_memory.hpp"
+#include "symbol_registry.hpp"
+
+// Shared-memory market data bus: one feed process publishes normalized ticks, any number
+// of processes map the same segment (POSIX shm, /dev/shm/<name>) and read them without a
+// syscall or a serialization step.
+//
+// The segment is a header, a table of consumer records and a ring of one-cache-line tick
+// slots. The producer never waits for anyone: it writes slot (index & mask) and bumps the
+// published count. Each slot carries a lap sequence (odd while being written, 2 * lap + 2
+// once published), so a consumer copying a slot out can tell a fresh tick from one the
+// producer has lapped and overwritten, seqlock style.
+//
+// Every consumer owns a record (cursor, overruns, pid) on a cache line of its own. A
+// consumer that falls more than half the ring behind is flagged slow by the producer,
+// which also frees the records of consumers whose process has gone. A lapped consumer
+// counts the ticks it lost and resynchronizes at the live edge.
+//
+// Idle consumers park on a SharedDoorbell in the header, rung after every publish.
+//
+// A producer that finds the segment with another layout (say a new capacity) does not
+// rewrite it under its consumers: it bumps the old header's epoch, rings its bell and
+// unlinks it, then creates a fresh segment with the next epoch. The old mapping stays
+// valid for the consumers still on it; they see the epoch change when they run dry and
+// re-attach to the new segment.
+
+constexpr uint32_t BUS_MAGIC = 0x53554248;    // "HBUS"
+constexpr uint32_t BUS_VERSION = 2;
+constexpr uint32_t BUS_MAX_CONSUMERS = 32;
+
+// One tick as published. Symbols travel as packed tickers, since every process numbers
+// its own SymbolIds.
+struct BusTick {
+    MarketTick::Kind kind = MarketTick::Kind::Quote;
+    uint16_t present = 0;              // QuoteField bits
+    SymbolKey symbol;
+    int64_t last = 0;                  // ticks
+    int64_t low = 0;
+    int64_t high = 0;
+    int64_t volume = 0;
+    int64_t stamp_ns = 0;              // steady_clock (system-wide): the publisher's poll start
+};
+
+// Slot layout: the BusTick fields around a lap sequence, in exactly one cache line.
+struct alignas(CACHE_LINE) BusSlot {
+    std::atomic<uint32_t> seq;
+    MarketTick::Kind kind;
+    uint8_t reserved;
+    uint16_t present;
+    SymbolKey symbol;
+    int64_t last;
+    int64_t low;
+    int64_t high;
+    int64_t volume;
+    int64_t stamp_ns;
+};
+
+static_assert(sizeof(BusSlot) == CACHE_LINE, "a bus slot is one cache line");
+
+// Claiming: taken by a subscriber that is still filling the record in; the producer only
+// looks at Active records, so it never judges one by its previous owner's pid.
+enum class BusConsumerState : uint32_t { Free, Claiming, Active };
+
+struct alignas(CACHE_LINE) BusConsumerRecord {
+    std::atomic<uint32_t> state;       // BusConsumerState
+    std::atomic<int32_t> pid;
+    std::atomic<uint64_t> cursor;      // next index to read
+    std::atomic<uint64_t> overruns;    // ticks lost to being lapped
+    std::atomic<uint64_t> slow_events; // times the producer found it SLOW_LAG_DIV behind
+    std::atomic<uint32_t> slow;        // currently flagged; cleared by the consumer once caught up
+    char name[20];
+};
+
+struct BusHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t capacity;                 // slots, a power of two
+    uint32_t slot_bytes;
+    uint32_t max_consumers;
+    std::atomic<int32_t> producer_pid;
+    std::atomic<uint32_t> epoch;       // bumped when a producer retires this segment
+    alignas(CACHE_LINE) std::atomic<uint64_t> published;  // ticks published so far
+    alignas(CACHE_LINE) SharedDoorbell bell;              // consumers park here
+    BusConsumerRecord consumers[BUS_MAX_CONSUMERS];
+};
+
+static_assert(sizeof(BusHeader) % CACHE_LINE == 0, "slots start on a cache line");
+
+// Gives a consumer record back (its owner closing, or the producer reclaiming it from a
+// dead process). pid is cleared first, so the next owner never inherits it.
+inline void releaseConsumer(BusConsumerRecord& c) {
+    c.pid.store(0, std::memory_order_relaxed);
+    c.state.store(static_cast<uint32_t>(BusConsumerState::Free), std::memory_order_release);
+}
+
+// HFT_BUS_PUBLISH=name publishes every decoded quote; HFT_BUS_SUBSCRIBE=name takes the feed
+// from the bus instead of the API. HFT_BUS_CAPACITY sizes a new bus (default 4096 slots).
+struct BusConfig {
+    std::string publish;
+    std::string subscribe;
+    std::string consumer = "market_maker";  // this subscriber's record name on the bus
+    size_t capacity = 4096;
+
+    static BusConfig fromEnv() {
+        BusConfig c;
+        if(const char* v = std::getenv("HFT_BUS_PUBLISH")) c.publish = v;
+        if(const char* v = std::getenv("HFT_BUS_SUBSCRIBE")) c.subscribe = v;
+        if(const char* v = std::getenv("HFT_BUS_CONSUMER"); v && *v) c.consumer = v;
+        if(const char* v = std::getenv("HFT_BUS_CAPACITY")) {
+            size_t n = static_cast<size_t>(std::strtoull(v, nullptr, 10));
+            if(n) c.capacity = n;
+        }
+        return c;
+    }
+};
+
+// Maps a bus segment; shared by both ends. The layout is read once at create/attach;
+// ring indexing uses the cached copy, not the shared header.
+class BusMapping {
+public:
+    // Creates or reuses /dev/shm/<name> sized for capacity slots (producer). A compatible
+    // segment keeps its published count, so attached consumers carry on across a producer
+    // restart; one with another layout is retired (see above) and replaced. EBUSY, leaving
+    // the segment alone, if another live process is publishing on it.
+    int create(const std::string& name, size_t capacity) {
+        uint32_t slots = 2;
+        while(slots < capacity) slots <<= 1;
+        size_t size = sizeof(BusHeader) + size_t{slots} * sizeof(BusSlot);
+        uint32_t epoch = 1;
+        int err = segment.attach(name);
+        if(err && err != ENOENT && err != EPROTO) return err;
+        if(!err) {
+            BusHeader& h = head();
+            if(segment.size() >= sizeof(BusHeader) && h.magic == BUS_MAGIC && h.version == BUS_VERSION) {
+                int other = h.producer_pid.load(std::memory_order_acquire);
+                if(other != 0 && other != getpid() && processAlive(other)) {
+                    segment.unmap();
+                    return EBUSY;
+                }
+                if(h.capacity == slots && h.slot_bytes == sizeof(BusSlot) && h.max_consumers == BUS_MAX_CONSUMERS &&
+                   segment.size() == size) {
+                    cacheLayout();
+                    return 0;
+                }
+                // unlinked first, so nobody re-attaching to the new epoch can map this one
+                remove(name);
+                epoch = h.epoch.load(std::memory_order_relaxed) + 1;
+                h.epoch.store(epoch, std::memory_order_release);
+                h.bell.wakeAll();
+            }
+            segment.unmap();
+            remove(name);
+        }
+        bool resized = false;
+        err = segment.create(name, size, resized);
+        if(err) return err;
+        std::memset(segment.data(), 0, size);
+        BusHeader& h = head();
+        h.version = BUS_VERSION;
+        h.capacity = slots;
+        h.slot_bytes = sizeof(BusSlot);
+        h.max_consumers = BUS_MAX_CONSUMERS;
+        h.epoch.store(epoch, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        h.magic = BUS_MAGIC;
+        cacheLayout();
+        return 0;
+    }
+
+    // Maps an existing bus (consumer). ENOENT when nobody has created it yet, EPROTO when
+    // it has another layout.
+    int attach(const std::string& name) {
+        int err = segment.attach(name);
+        if(err) return err;
+        const BusHeader& h = head();
+        if(segment.size() < sizeof(BusHeader) || h.magic != BUS_MAGIC || h.version != BUS_VERSION ||
+           h.slot_bytes != sizeof(BusSlot) || h.max_consumers != BUS_MAX_CONSUMERS ||
+           sizeof(BusHeader) + size_t{h.capacity} * sizeof(BusSlot) != segment.size()) {
+            segment.unmap();
+            return EPROTO;
+        }
+        cacheLayout();
+        return 0;
+    }
+
+    static void remove(const std::string& name) { ShmSegment::remove(name); }
+
+    bool mapped() const { return segment.mapped(); }
+    BusHeader& head() const { return *static_cast<BusHeader*>(segment.data()); }
+    BusSlot& slot(uint64_t index) const { return slots[index & mask]; }
+    uint32_t capacity() const { return static_cast<uint32_t>(mask + 1); }
+    // Sequence of a published slot for this index: 2 * lap + 2, wrapping harmlessly.
+    uint32_t publishedSeq(uint64_t index) const { return static_cast<uint32_t>((index >> shift) * 2 + 2); }
+    // A producer has replaced this segment with a new one under the same name.
+    bool retired() const { return head().epoch.load(std::memory_order_acquire) != epoch; }
+
+private:
+    void cacheLayout() {
+        slots = reinterpret_cast<BusSlot*>(static_cast<char*>(segment.data()) + sizeof(BusHeader));
+        mask = head().capacity - 1;
+        shift = static_cast<uint32_t>(__builtin_ctzll(head().capacity));
+        epoch = head().epoch.load(std::memory_order_acquire);
+    }
+
+    ShmSegment segment;
+    BusSlot* slots = nullptr;
+    uint64_t mask = 0;
+    uint32_t shift = 0;
+    uint32_t epoch = 0;
+};
+
+struct BusConsumerInfo {
+    std::string name;
+    int pid = 0;
+    uint64_t lag = 0;                  // ticks published but not yet read
+    uint64_t overruns = 0;
+    uint64_t slow_events = 0;
+    bool slow = false;
+};
+
+// Single producer. Never blocks: slow consumers are flagged and eventually lapped.
+class MarketBusPublisher {
+public:
+    static constexpr size_t SLOW_LAG_DIV = 2;        // flagged slow past capacity / 2 of lag
+
+    // EBUSY if another live process is publishing on this bus.
+    int open(const std::string& name, size_t capacity) {
+        int err = bus.create(name, capacity);
+        if(err) return err;
+        bus.head().producer_pid.store(getpid(), std::memory_order_release);
+        next = bus.head().published.load(std::memory_order_acquire);
+        check_every = std::max<uint64_t>(1, bus.capacity() / 8);
+        return 0;
+    }
+
+    bool isOpen() const { return bus.mapped(); }
+    size_t capacity() const { return bus.capacity(); }
+
+    void publish(const BusTick& t) {
+        BusSlot& s = bus.slot(next);
+        uint32_t seq = bus.publishedSeq(next);
+        s.seq.store(seq - 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        s.kind = t.kind;
+        s.present = t.present;
+        s.symbol = t.symbol;
+        s.last = t.last;
+        s.low = t.low;
+        s.high = t.high;
+        s.volume = t.volume;
+        s.stamp_ns = t.stamp_ns;
+        s.seq.store(seq, std::memory_order_release);
+        bus.head().published.store(++next, std::memory_order_release);
+
+        bus.head().bell.ring();
+        if(next % check_every == 0) checkConsumers();
+    }
+
+    uint64_t published() const { return next; }
+
+    // Flags consumers more than capacity / SLOW_LAG_DIV behind and frees the records
+    // of dead processes. Runs every capacity / 8 publishes; callable any time.
+    void checkConsumers() {
+        uint64_t limit = bus.capacity() / SLOW_LAG_DIV;
+        for(BusConsumerRecord& c : bus.head().consumers) {
+            if(c.state.load(std::memory_order_acquire) != static_cast<uint32_t>(BusConsumerState::Active)) continue;
+            int pid = c.pid.load(std::memory_order_relaxed);
+            if(pid != 0 && !processAlive(pid)) {
+                releaseConsumer(c);
+                continue;
+            }
+            uint64_t cursor = c.cursor.load(std::memory_order_relaxed);
+            if(next - cursor > limit && !c.slow.load(std::memory_order_relaxed)) {
+                c.slow.store(1, std::memory_order_relaxed);
+                c.slow_events.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Any thread, for reports.
+    std::vector<BusConsumerInfo> consumers() const {
+        uint64_t published = bus.head().published.load(std::memory_order_acquire);
+        std::vector<BusConsumerInfo> out;
+        for(const BusConsumerRecord& c : bus.head().consumers) {
+            if(c.state.load(std::memory_order_acquire) != static_cast<uint32_t>(BusConsumerState::Active)) continue;
+            BusConsumerInfo info;
+            info.name.assign(c.name, strnlen(c.name, sizeof(c.name)));
+            info.pid = c.pid.load(std::memory_order_relaxed);
+            uint64_t cursor = c.cursor.load(std::memory_order_relaxed);
+            info.lag = published > cursor ? published - cursor : 0;
+            info.overruns = c.overruns.load(std::memory_order_relaxed);
+            info.slow_events = c.slow_events.load(std::memory_order_relaxed);
+            info.slow = c.slow.load(std::memory_order_relaxed) != 0;
+            out.push_back(std::move(info));
+        }
+        return out;
+    }
+
+private:
+    BusMapping bus;
+    uint64_t next = 0;
+    uint64_t check_every = 1;
+};
+
+// One consumer. Reads from its own cursor; never slows the producer down.
+class MarketBusSubscriber {
+public:
+    // Reattached: the producer replaced the bus (see above); reading resumes at the live
+    // edge of the new one.
+    enum class Read : uint8_t { Tick, Empty, Overrun, Reattached };
+
+    MarketBusSubscriber() = default;
+    MarketBusSubscriber(const MarketBusSubscriber&) = delete;
+    MarketBusSubscriber& operator=(const MarketBusSubscriber&) = delete;
+    ~MarketBusSubscriber() { close(); }
+
+    // Attaches and claims a consumer record, starting at the live edge. ENOSPC when every
+    // record is taken.
+    int open(const std::string& bus_name, const std::string& consumer_name) {
+        close();
+        int err = bus.attach(bus_name);
+        if(err) return err;
+        BusConsumerRecord* c = claim(bus, consumer_name);
+        if(!c) return ENOSPC;
+        name = bus_name;
+        consumer = consumer_name;
+        own = c;
+        cursor = c->cursor.load(std::memory_order_relaxed);
+        header.store(&bus.head(), std::memory_order_release);
+        record.store(c, std::memory_order_release);
+        return 0;
+    }
+
+    void close() {
+        if(own) releaseConsumer(*own);
+        own = nullptr;
+        record.store(nullptr, std::memory_order_release);
+    }
+
+    bool isOpen() const { return own != nullptr; }
+
+    // Copies the next tick out. Overrun: the producer lapped us; the lost ticks are
+    // counted and the cursor jumps to the live edge.
+    Read poll(BusTick& out) {
+        const BusSlot& s = bus.slot(cursor);
+        uint32_t want = bus.publishedSeq(cursor);
+        uint32_t seq = s.seq.load(std::memory_order_acquire);
+        if(seq == want) {
+            out.kind = s.kind;
+            out.present = s.present;
+            out.symbol = s.symbol;
+            out.last = s.last;
+            out.low = s.low;
+            out.high = s.high;
+            out.volume = s.volume;
+            out.stamp_ns = s.stamp_ns;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(s.seq.load(std::memory_order_relaxed) == want) {
+                own->cursor.store(++cursor, std::memory_order_release);
+                if(own->slow.load(std::memory_order_relaxed) && available() == 0) {
+                    own->slow.store(0, std::memory_order_relaxed);
+                }
+                return Read::Tick;
+            }
+        } else if(static_cast<int32_t>(seq - want) < 0) {
+            // not published yet (or still being written), or never will be on a retired bus
+            return bus.retired() ? reattach() : Read::Empty;
+        }
+        uint64_t live = bus.head().published.load(std::memory_order_acquire);
+        own->overruns.fetch_add(live - cursor, std::memory_order_relaxed);
+        cursor = live;
+        own->cursor.store(cursor, std::memory_order_release);
+        return Read::Overrun;
+    }
+
+    // Ticks published but not read yet; any thread.
+    uint64_t available() const {
+        const BusHeader* h = header.load(std::memory_order_acquire);
+        const BusConsumerRecord* c = record.load(std::memory_order_acquire);
+        if(!h || !c) return 0;
+        return h->published.load(std::memory_order_acquire) - c->cursor.load(std::memory_order_acquire);
+    }
+
+    // Parks until the producer publishes or interrupt() is called, unless ready() is
+    // already true once parked (see Doorbell::park). May return spuriously. Never parks
+    // on a retired bus, whose bell nobody rings any more.
+    template<class Ready>
+    void park(Ready&& ready) {
+        bus.head().bell.park([&] { return bus.retired() || ready(); });
+    }
+
+    // Any thread: wakes parked consumers (every one on the bus; the others see a spurious
+    // wake-up and park again).
+    void interrupt() const {
+        if(BusHeader* h = header.load(std::memory_order_acquire)) h->bell.wakeAll();
+    }
+
+    uint64_t overruns() const { return counter(&BusConsumerRecord::overruns); }
+    bool flaggedSlow() const {
+        const BusConsumerRecord* c = record.load(std::memory_order_acquire);
+        return c && c->slow.load(std::memory_order_relaxed) != 0;
+    }
+    uint64_t slowEvents() const { return counter(&BusConsumerRecord::slow_events); }
+
+private:
+    static BusConsumerRecord* claim(BusMapping& m, const std::string& consumer_name) {
+        for(BusConsumerRecord& c : m.head().consumers) {
+            uint32_t expected = static_cast<uint32_t>(BusConsumerState::Free);
+            if(!c.state.compare_exchange_strong(expected, static_cast<uint32_t>(BusConsumerState::Claiming))) continue;
+            std::memset(c.name, 0, sizeof(c.name));
+            std::memcpy(c.name, consumer_name.data(), std::min(consumer_name.size(), sizeof(c.name) - 1));
+            c.pid.store(getpid(), std::memory_order_relaxed);
+            c.overruns.store(0, std::memory_order_relaxed);
+            c.slow_events.store(0, std::memory_order_relaxed);
+            c.slow.store(0, std::memory_order_relaxed);
+            c.cursor.store(m.head().published.load(std::memory_order_acquire), std::memory_order_relaxed);
+            c.state.store(static_cast<uint32_t>(BusConsumerState::Active), std::memory_order_release);
+            return &c;
+        }
+        return nullptr;
+    }
+
+    // Moves to the segment that replaced ours, carrying the overrun count over. Empty
+    // while the new one is not there yet. The old mapping stays mapped (other threads may
+    // still be reading through it) until the next reattach.
+    Read reattach() {
+        BusMapping fresh;
+        if(fresh.attach(name) != 0 || fresh.retired()) return Read::Empty;
+        BusConsumerRecord* c = claim(fresh, consumer);
+        if(!c) return Read::Empty;
+        c->overruns.store(own->overruns.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        releaseConsumer(*own);
+        previous = std::move(bus);
+        bus = std::move(fresh);
+        own = c;
+        cursor = c->cursor.load(std::memory_order_relaxed);
+        header.store(&bus.head(), std::memory_order_release);
+        record.store(c, std::memory_order_release);
+        return Read::Reattached;
+    }
+
+    uint64_t counter(std::atomic<uint64_t> BusConsumerRecord::*field) const {
+        const BusConsumerRecord* c = record.load(std::memory_order_acquire);
+        return c ? (c->*field).load(std::memory_order_relaxed) : 0;
+    }
+
+    BusMapping bus;
+    BusMapping previous;               // retired segment, see reattach
+    BusConsumerRecord* own = nullptr;  // our record in bus (polling thread)
+    uint64_t cursor = 0;
+    std::string name;
+    std::string consumer;
+    // Copies of bus.head() and own for the any-thread accessors, swapped on reattach.
+    std::atomic<BusHeader*> header{nullptr};
+    std::atomic<BusConsumerRecord*> record{nullptr};
+};
@@ -0,0 +1,183 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include "decimal.hpp"
+#include "quote_parser.hpp"
+
+// Normalized market data records produced by every decoder (JSON backends, CSV).
+// Prices are int64 ticks of 10^-PRICE_DECIMALS, dates are packed decimal (yyyymmdd).
+
+constexpr size_t SYMBOL_CAPACITY = 16;
+
+struct QuoteRecord {
+    char symbol[SYMBOL_CAPACITY] = {};
+    int64_t open = 0;
+    int64_t high = 0;
+    int64_t low = 0;
+    int64_t price = 0;
+    int64_t volume = 0;
+    int64_t previous_close = 0;
+    int64_t change = 0;
+    int64_t change_percent = 0;  // 10^-4 percent
+    int32_t trading_day = 0;     // yyyymmdd
+    uint16_t present = 0;        // bit per QuoteField
+
+    std::string_view symbolView() const { return std::string_view(symbol, strnlen(symbol, SYMBOL_CAPACITY)); }
+    bool has(QuoteField f) const { return present & (1u << static_cast<int>(f)); }
+
+    bool operator==(const QuoteRecord& o) const {
+        return symbolView() == o.symbolView() && open == o.open && high == o.high && low == o.low &&
+               price == o.price && volume == o.volume && previous_close == o.previous_close &&
+               change == o.change && change_percent == o.change_percent &&
+               trading_day == o.trading_day && present == o.present;
+    }
+    bool operator!=(const QuoteRecord& o) const { return !(*this == o); }
+};
+
+enum class BarField : uint8_t { Open, High, Low, Close, Volume, Count };
+
+// One intraday OHLCV bar.
+struct Bar {
+    int64_t time = 0;  // yyyymmddhhmmss
+    int64_t open = 0;
+    int64_t high = 0;
+    int64_t low = 0;
+    int64_t close = 0;
+    int64_t volume = 0;
+    uint8_t present = 0;  // bit per BarField
+
+    bool complete() const { return present == (1u << static_cast<int>(BarField::Count)) - 1; }
+
+    bool operator==(const Bar& o) const {
+        return time == o.time && open == o.open && high == o.high && low == o.low &&
+               close == o.close && volume == o.volume && present == o.present;
+    }
+    bool operator!=(const Bar& o) const { return !(*this == o); }
+};
+
+namespace market_data_detail {
+    inline bool fixedDigits(const char* p, int n, int64_t& out) {
+        int64_t v = 0;
+        for(int i = 0; i < n; ++i) {
+            unsigned d = static_cast<unsigned char>(p[i]) - '0';
+            if(d > 9) return false;
+            v = v * 10 + d;
+        }
+        out = v;
+        return true;
+    }
+}
+
+// Symbols longer than SYMBOL_CAPACITY - 1 are rejected.
+inline bool setSymbol(char (&dst)[SYMBOL_CAPACITY], std::string_view sym) {
+    if(sym.size() >= SYMBOL_CAPACITY) return false;
+    std::memset(dst, 0, SYMBOL_CAPACITY);
+    std::memcpy(dst, sym.data(), sym.size());
+    return true;
+}
+
+// "2024-10-04" (anything after the date is ignored) to 20241004.
+inline bool parseDate(std::string_view text, int32_t& out) {
+    using market_data_detail::fixedDigits;
+    int64_t y, m, d;
+    if(text.size() < 10 || text[4] != '-' || text[7] != '-') return false;
+    if(!fixedDigits(text.data(), 4, y) || !fixedDigits(text.data() + 5, 2, m) || !fixedDigits(text.data() + 8, 2, d)) {
+        return false;
+    }
+    out = static_cast<int32_t>(y * 10000 + m * 100 + d);
+    return true;
+}
+
+// "2024-10-04 19:55:00" to 20241004195500.
+inline bool parseDateTime(std::string_view text, int64_t& out) {
+    using market_data_detail::fixedDigits;
+    int32_t date;
+    int64_t h, m, s;
+    if(text.size() < 19 || !parseDate(text, date) || text[13] != ':' || text[16] != ':') return false;
+    if(!fixedDigits(text.data() + 11, 2, h) || !fixedDigits(text.data() + 14, 2, m) || !fixedDigits(text.data() + 17, 2, s)) {
+        return false;
+    }
+    out = static_cast<int64_t>(date) * 1'000'000 + h * 10'000 + m * 100 + s;
+    return true;
+}
+
+// Converts one textual field into rec and marks it present. False if the value is malformed.
+inline bool applyQuoteField(QuoteRecord& rec, QuoteField field, std::string_view value) {
+    bool ok = false;
+    switch(field) {
+        case QuoteField::Symbol: ok = setSymbol(rec.symbol, value); break;
+        case QuoteField::Open: ok = parsePrice(value, rec.open) == DecimalStatus::Ok; break;
+        case QuoteField::High: ok = parsePrice(value, rec.high) == DecimalStatus::Ok; break;
+        case QuoteField::Low: ok = parsePrice(value, rec.low) == DecimalStatus::Ok; break;
+        case QuoteField::Price: ok = parsePrice(value, rec.price) == DecimalStatus::Ok; break;
+        case QuoteField::Volume: ok = parseInteger(value, rec.volume) == DecimalStatus::Ok; break;
+        case QuoteField::LatestTradingDay: ok = parseDate(value, rec.trading_day); break;
+        case QuoteField::PreviousClose: ok = parsePrice(value, rec.previous_close) == DecimalStatus::Ok; break;
+        case QuoteField::Change: ok = parsePrice(value, rec.change) == DecimalStatus::Ok; break;
+        case QuoteField::ChangePercent: ok = parsePercent(value, rec.change_percent) == DecimalStatus::Ok; break;
+        case QuoteField::Count: break;
+    }
+    if(ok) rec.present |= static_cast<uint16_t>(1u << static_cast<int>(field));
+    return ok;
+}
+
+inline bool applyBarField(Bar& bar, BarField field, std::string_view value) {
+    bool ok = false;
+    switch(field) {
+        case BarField::Open: ok = parsePrice(value, bar.open) == DecimalStatus::Ok; break;
+        case BarField::High: ok = parsePrice(value, bar.high) == DecimalStatus::Ok; break;
+        case BarField::Low: ok = parsePrice(value, bar.low) == DecimalStatus::Ok; break;
+        case BarField::Close: ok = parsePrice(value, bar.close) == DecimalStatus::Ok; break;
+        case BarField::Volume: ok = parseInteger(value, bar.volume) == DecimalStatus::Ok; break;
+        case BarField::Count: break;
+    }
+    if(ok) bar.present |= static_cast<uint8_t>(1u << static_cast<int>(field));
+    return ok;
+}
+
+// Converts the string views of a parsed GLOBAL_QUOTE. Fields that fail to parse are left absent.
+inline QuoteRecord toQuoteRecord(const GlobalQuote& quote) {
+    QuoteRecord rec;
+    for(int i = 0; i < static_cast<int>(QuoteField::Count); ++i) {
+        QuoteField f = static_cast<QuoteField>(i);
+        if(quote.has(f)) applyQuoteField(rec, f, quote[f]);
+    }
+    return rec;
+}
+
+// Key names as they appear on the wire. Used by decoders that match keys by name
+// rather than by the fixed-schema numeric prefix.
+
+inline bool globalQuoteField(std::string_view key, QuoteField& out) {
+    static constexpr std::string_view KEYS[] = {
+        "01. symbol", "02. open", "03. high", "04. low", "05. price", "06. volume",
+        "07. latest trading day", "08. previous close", "09. change", "10. change percent"
+    };
+    for(int i = 0; i < static_cast<int>(QuoteField::Count); ++i) {
+        if(KEYS[i] == key) { out = static_cast<QuoteField>(i); return true; }
+    }
+    return false;
+}
+
+// REALTIME_BULK_QUOTES element keys. "close" is the latest price; extended-hours keys are ignored.
+inline bool bulkQuoteField(std::string_view key, QuoteField& out) {
+    static constexpr std::string_view KEYS[] = {
+        "symbol", "open", "high", "low", "close", "volume",
+        "timestamp", "previous_close", "change", "change_percent"
+    };
+    for(int i = 0; i < static_cast<int>(QuoteField::Count); ++i) {
+        if(KEYS[i] == key) { out = static_cast<QuoteField>(i); return true; }
+    }
+    return false;
+}
+
+// TIME_SERIES_INTRADAY bar keys ("1. open" ... "5. volume").
+inline bool barField(std::string_view key, BarField& out) {
+    static constexpr std::string_view KEYS[] = { "1. open", "2. high", "3. low", "4. close", "5. volume" };
+    for(int i = 0; i < static_cast<int>(BarField::Count); ++i) {
+        if(KEYS[i] == key) { out = static_cast<BarField>(i); return true; }
+    }
+    return false;
+}
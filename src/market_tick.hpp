@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+
+#include "aligned.hpp"
+#include "fixed_point.hpp"
+#include "market_data.hpp"
+#include "symbol_registry.hpp"
+
+// Normalized market update passed from the feed thread to the strategy thread, one cache
+// line per tick. A poll publishes one Quote tick per decoded record followed by a PollDone
+// (or PollFailed) marker that closes the cycle on the strategy side.
+struct MarketTick {
+    enum class Kind : uint8_t { Quote, PollDone, PollFailed };
+
+    Kind kind = Kind::Quote;
+    uint16_t present = 0;        // QuoteField bits
+    SymbolId symbol = INVALID_SYMBOL;
+    int64_t last = 0;            // ticks
+    int64_t low = 0;
+    int64_t high = 0;
+    int64_t volume = 0;
+    int64_t request_ns = 0;      // steady_clock: poll started
+    int64_t decoded_ns = 0;      // steady_clock: record decoded and pushed
+
+    static MarketTick quote(SymbolId id, const QuoteRecord& rec, int64_t request_ns, int64_t now_ns) {
+        MarketTick t;
+        t.symbol = id;
+        t.present = rec.present;
+        t.last = rec.price;
+        t.low = rec.low;
+        t.high = rec.high;
+        t.volume = rec.volume;
+        t.request_ns = request_ns;
+        t.decoded_ns = now_ns;
+        return t;
+    }
+
+    static MarketTick marker(Kind kind, int64_t request_ns, int64_t now_ns) {
+        MarketTick t;
+        t.kind = kind;
+        t.request_ns = request_ns;
+        t.decoded_ns = now_ns;
+        return t;
+    }
+
+    // The fields SymbolStateTable::applyQuote reads.
+    QuoteRecord record() const {
+        QuoteRecord r;
+        r.present = present;
+        r.price = last;
+        r.low = low;
+        r.high = high;
+        r.volume = volume;
+        return r;
+    }
+};
+
+static_assert(sizeof(MarketTick) <= CACHE_LINE, "a tick should fit one ring slot line");
+
+// Count, mean and max of one pipeline hop over a reporting interval.
+struct HopLatency {
+    uint64_t count = 0;
+    int64_t total_ns = 0;
+    int64_t max_ns = 0;
+
+    void add(int64_t ns) {
+        ++count;
+        total_ns += ns;
+        if(ns > max_ns) max_ns = ns;
+    }
+    double meanUs() const { return count ? total_ns / 1000.0 / static_cast<double>(count) : 0.0; }
+    double maxUs() const { return max_ns / 1000.0; }
+    void reset() { *this = HopLatency{}; }
+};
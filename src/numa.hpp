@@ -0,0 +1,201 @@
+#pragma once
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "page_memory.hpp"
+
+// NUMA topology and memory placement.
+// On a multi-socket box a cache miss to a page on the other socket costs a cross-socket
+// hop, so each structure should live on the node of the thread that owns it. Topology
+// comes from /sys/devices/system/node at startup (one node holding every CPU when the
+// kernel has no NUMA support). NumaPlacement moves the pages of structures that are already
+// built onto a node (bindToNode in page_memory.hpp) and checks where they ended up, for the
+// placement report. Placement is per page: arrays of a page or more have pages of their
+// own (see AlignedArray), smaller ones go with whatever shares their page.
+
+struct NumaNode {
+    int id = 0;
+    std::vector<int> cpus;
+    std::vector<int> distance;         // to each node, in nodes() order; 10 = local
+};
+
+class NumaTopology {
+public:
+    static constexpr const char* SYSFS_ROOT = "/sys/devices/system/node";
+
+    static NumaTopology discover(const std::string& root = SYSFS_ROOT) {
+        NumaTopology t;
+        for(int id : parseCpuList(readLine(root + "/online"))) {
+            std::string dir = root + "/node" + std::to_string(id);
+            NumaNode n;
+            n.id = id;
+            n.cpus = parseCpuList(readLine(dir + "/cpulist"));
+            std::istringstream distances(readLine(dir + "/distance"));
+            for(int d; distances >> d;) n.distance.push_back(d);
+            t.all.push_back(std::move(n));
+        }
+        if(t.all.empty()) {
+            NumaNode n;
+            for(unsigned c = 0; c < std::max(1u, std::thread::hardware_concurrency()); ++c) n.cpus.push_back(static_cast<int>(c));
+            n.distance.push_back(10);
+            t.all.push_back(std::move(n));
+        }
+        return t;
+    }
+
+    const std::vector<NumaNode>& nodes() const { return all; }
+    size_t size() const { return all.size(); }
+    bool numa() const { return all.size() > 1; }
+
+    // Node id of a CPU, -1 if it is not online.
+    int nodeOfCpu(int cpu) const {
+        for(const NumaNode& n : all) {
+            if(std::find(n.cpus.begin(), n.cpus.end(), cpu) != n.cpus.end()) return n.id;
+        }
+        return -1;
+    }
+
+    // SLIT distance between two node ids (10 local, ~20+ remote); 0 if unknown.
+    int distance(int from, int to) const {
+        size_t f = indexOf(from);
+        size_t t = indexOf(to);
+        if(f == all.size() || t == all.size() || t >= all[f].distance.size()) return 0;
+        return all[f].distance[t];
+    }
+
+    // "0-3,8,10-11" -> {0, 1, 2, 3, 8, 10, 11}
+    static std::vector<int> parseCpuList(const std::string& list) {
+        std::vector<int> out;
+        std::istringstream in(list);
+        for(std::string range; std::getline(in, range, ',');) {
+            if(range.empty()) continue;
+            char* end = nullptr;
+            long lo = std::strtol(range.c_str(), &end, 10);
+            long hi = *end == '-' ? std::strtol(end + 1, nullptr, 10) : lo;
+            for(long c = lo; c <= hi; ++c) out.push_back(static_cast<int>(c));
+        }
+        return out;
+    }
+
+    // "0-3,8" again, for reports.
+    static std::string formatCpuList(const std::vector<int>& cpus) {
+        std::string out;
+        for(size_t i = 0; i < cpus.size();) {
+            size_t j = i;
+            while(j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) ++j;
+            if(!out.empty()) out += ',';
+            out += std::to_string(cpus[i]);
+            if(j > i) out.append("-").append(std::to_string(cpus[j]));
+            i = j + 1;
+        }
+        return out;
+    }
+
+private:
+    static std::string readLine(const std::string& path) {
+        std::ifstream f(path);
+        std::string line;
+        std::getline(f, line);
+        return line;
+    }
+
+    size_t indexOf(int id) const {
+        size_t i = 0;
+        while(i < all.size() && all[i].id != id) ++i;
+        return i;
+    }
+
+    std::vector<NumaNode> all;
+};
+
+// Node the calling thread is running on right now (0 without NUMA support).
+inline int currentNumaNode() {
+    unsigned cpu = 0;
+    unsigned node = 0;
+    return syscall(SYS_getcpu, &cpu, &node, nullptr) == 0 ? static_cast<int>(node) : 0;
+}
+
+struct PageResidency {
+    size_t pages = 0;
+    size_t resident = 0;
+    size_t on_node = 0;
+};
+
+// Pages of [p, p + bytes), how many are resident and how many of those are on `node`
+// (move_pages in query mode, which moves nothing).
+inline PageResidency residencyOn(const void* p, size_t bytes, int node) {
+    PageResidency r;
+    uintptr_t start = reinterpret_cast<uintptr_t>(p) & ~(SMALL_PAGE - 1);
+    uintptr_t end = (reinterpret_cast<uintptr_t>(p) + bytes + SMALL_PAGE - 1) & ~(SMALL_PAGE - 1);
+    std::vector<void*> pages;
+    for(uintptr_t a = start; a < end; a += SMALL_PAGE) pages.push_back(reinterpret_cast<void*>(a));
+    std::vector<int> status(pages.size(), -1);
+    r.pages = pages.size();
+    if(pages.empty() || syscall(SYS_move_pages, 0, pages.size(), pages.data(), nullptr, status.data(), 0) != 0) return r;
+    for(int s : status) {
+        if(s < 0) continue;
+        ++r.resident;
+        if(s == node) ++r.on_node;
+    }
+    return r;
+}
+
+// Moves structures onto nodes and records the outcome, one entry per name and node.
+// Memory inside the huge-page region is left where low-jitter startup bound it, since
+// binding part of a 2MB page would split it.
+class NumaPlacement {
+public:
+    struct Entry {
+        const char* what;
+        int node;
+        size_t bytes = 0;
+        PageResidency residency;
+        size_t in_region = 0;          // bytes left in the huge-page region
+        int error = 0;                 // first bindToNode failure
+    };
+
+    void place(const char* what, void* p, size_t bytes, int node) {
+        if(!p || bytes == 0 || node < 0) return;
+        Entry& e = entryFor(what, node);
+        e.bytes += bytes;
+        if(HugePageRegion::instance().contains(p)) {
+            e.in_region += bytes;
+            return;
+        }
+        int err = bindToNode(p, bytes, node);
+        if(err && !e.error) e.error = err;
+        PageResidency r = residencyOn(p, bytes, node);
+        e.residency.pages += r.pages;
+        e.residency.resident += r.resident;
+        e.residency.on_node += r.on_node;
+    }
+
+    // Every block of a structure with a memoryBlocks(fn) member.
+    template<class S>
+    void placeAll(const char* what, S& s, int node) {
+        s.memoryBlocks([&](void* p, size_t bytes) { place(what, p, bytes, node); });
+    }
+
+    const std::vector<Entry>& entries() const { return placed; }
+
+private:
+    Entry& entryFor(const char* what, int node) {
+        for(Entry& e : placed) {
+            if(e.node == node && std::string(e.what) == what) return e;
+        }
+        placed.push_back(Entry{what, node});
+        return placed.back();
+    }
+
+    std::vector<Entry> placed;
+};
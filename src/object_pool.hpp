@@ -0,0 +1,86 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#include "aligned.hpp"
+
+// Fixed-capacity object pool. Slots are preallocated at construction, each on its own cache
+// line, and free slots are chained through an intrusive free list, so acquire() and
+// release() are a couple of pointer moves with no heap traffic. When every slot is in use
+// acquire() returns nullptr and the miss is counted; callers decide whether to drop or
+// degrade. Single-threaded: the owning thread acquires and releases.
+
+struct PoolStats {
+    size_t capacity = 0;
+    size_t in_use = 0;
+    size_t high_water = 0;   // most slots ever in use at once
+    uint64_t exhausted = 0;  // acquire() calls that found the pool empty
+};
+
+template<class T>
+class ObjectPool {
+    struct alignas(CACHE_LINE) Slot {
+        union {
+            Slot* next;
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+    };
+
+public:
+    explicit ObjectPool(size_t capacity = 0) : slots(capacity) {
+        for(size_t i = capacity; i-- > 0;) {
+            slots[i].next = free_list;
+            free_list = &slots[i];
+        }
+    }
+    ObjectPool(ObjectPool&& o) noexcept
+        : slots(std::move(o.slots)), free_list(std::exchange(o.free_list, nullptr)), counts(std::exchange(o.counts, PoolStats{})) {}
+    ObjectPool& operator=(ObjectPool&& o) noexcept {
+        slots = std::move(o.slots);
+        free_list = std::exchange(o.free_list, nullptr);
+        counts = std::exchange(o.counts, PoolStats{});
+        return *this;
+    }
+
+    // Constructs a T in a free slot; nullptr when the pool is exhausted.
+    template<class... Args>
+    T* acquire(Args&&... args) {
+        Slot* s = free_list;
+        if(!s) {
+            ++counts.exhausted;
+            return nullptr;
+        }
+        free_list = s->next;
+        if(++counts.in_use > counts.high_water) counts.high_water = counts.in_use;
+        return new(s->storage) T{std::forward<Args>(args)...};
+    }
+
+    void release(T* obj) {
+        if(!obj) return;
+        obj->~T();
+        Slot* s = reinterpret_cast<Slot*>(obj);
+        s->next = free_list;
+        free_list = s;
+        --counts.in_use;
+    }
+
+    size_t capacity() const { return slots.size(); }
+    size_t inUse() const { return counts.in_use; }
+    size_t available() const { return slots.size() - counts.in_use; }
+    PoolStats stats() const {
+        PoolStats s = counts;
+        s.capacity = slots.size();
+        return s;
+    }
+
+    // fn(data, bytes) for the slot array (NUMA placement).
+    template<class Fn>
+    void memoryBlocks(Fn&& fn) { fn(slots.data(), slots.bytes()); }
+
+private:
+    AlignedArray<Slot> slots;
+    Slot* free_list = nullptr;
+    PoolStats counts;
+};
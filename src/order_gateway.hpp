@@ -0,0 +1,432 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+
+#include "aligned.hpp"
+#include "fixed_point.hpp"
+#include "orders.hpp"
+#include "shared_memory.hpp"
+#include "symbol_registry.hpp"
+
+// Shared-memory order gateway: strategy processes hand orders to an execution process
+// (the gateway, which owns the routing) and get acknowledgements and fills back, without a
+// socket or a serialization step in between.
+//
+// The segment (/dev/shm/<name>) holds a fixed number of channels. A strategy claims one
+// and owns the producer end of its request ring and the consumer end of its response
+// ring; the gateway owns the other two ends, so every ring is single-producer/single-
+// consumer (SharedSpscRing). Messages are fixed-size, one cache line, plain binary.
+// Neither side ever blocks on a full ring: send() and respond() fail and the caller
+// decides. The gateway parks on one SharedDoorbell that every client rings after a send;
+// each client parks on its channel's bell, rung after every response.
+//
+// A client gives its channel back with close(); the gateway also reclaims the channels of
+// clients whose process has gone (see reap). Either way the gateway resets the channel's
+// rings itself, since it is the only party left on them.
+//
+// A restarted gateway never rewrites the segment under running clients. It unlinks the old
+// segment, bumps its epoch and wakes everyone parked on it, then creates a fresh one with
+// the next epoch. The old mapping stays valid for the clients still on it; they see the
+// epoch change on their next send() or empty receive() and re-open on the new segment.
+// Orders in flight on the old gateway are gone; reconnects() counts these re-opens.
+
+constexpr uint32_t GATEWAY_MAGIC = 0x57544748;    // "HGTW"
+constexpr uint32_t GATEWAY_VERSION = 2;
+constexpr uint32_t GATEWAY_MAX_CHANNELS = 16;
+
+enum class OrderRequestKind : uint8_t { New, Cancel };
+
+// Strategy -> gateway. Cancel refers to the New with the same client_order_id.
+struct alignas(CACHE_LINE) OrderRequest {
+    OrderRequestKind kind = OrderRequestKind::New;
+    Side side = Side::Buy;
+    uint16_t reserved = 0;
+    uint32_t reserved2 = 0;
+    SymbolKey symbol;
+    uint64_t client_order_id = 0;      // unique per channel, chosen by the strategy
+    Price price;
+    int64_t qty = 0;
+    int64_t sent_ns = 0;               // steady_clock (system-wide), echoed in responses
+};
+
+enum class OrderResponseKind : uint8_t { Ack, Reject, Cancelled, Fill };
+
+enum class RejectReason : uint16_t { None, UnknownOrder, Risk, Busy };
+
+// Gateway -> strategy.
+struct alignas(CACHE_LINE) OrderResponse {
+    OrderResponseKind kind = OrderResponseKind::Ack;
+    Side side = Side::Buy;
+    RejectReason reason = RejectReason::None;
+    uint32_t reserved = 0;
+    uint64_t client_order_id = 0;
+    uint64_t exchange_order_id = 0;
+    Price price;                       // fill price for Fill
+    int64_t qty = 0;                   // filled quantity for Fill
+    int64_t sent_ns = 0;               // the request's
+    int64_t gateway_ns = 0;            // steady_clock: response written
+};
+
+static_assert(sizeof(OrderRequest) == CACHE_LINE && sizeof(OrderResponse) == CACHE_LINE,
+              "gateway messages are one cache line");
+
+enum class GatewayChannelState : uint32_t { Free, Claimed, Closing };
+
+struct alignas(CACHE_LINE) GatewayChannel {
+    std::atomic<uint32_t> state;       // GatewayChannelState
+    std::atomic<int32_t> pid;
+    std::atomic<uint32_t> session;     // bumped by every claim
+    char name[20];
+    SharedRingIndices requests;
+    SharedRingIndices responses;
+    alignas(CACHE_LINE) SharedDoorbell response_bell;    // the client parks here
+};
+
+struct GatewayHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t channels;                 // usable channels, <= GATEWAY_MAX_CHANNELS
+    uint32_t capacity;                 // slots per ring, a power of two
+    uint32_t request_bytes;
+    uint32_t response_bytes;
+    std::atomic<int32_t> gateway_pid;
+    std::atomic<uint32_t> epoch;       // bumped when a restarted gateway retires this segment
+    alignas(CACHE_LINE) SharedDoorbell request_bell;     // the gateway parks here
+    GatewayChannel channel[GATEWAY_MAX_CHANNELS];
+};
+
+static_assert(sizeof(GatewayHeader) % CACHE_LINE == 0, "ring slots start on a cache line");
+
+// Maps a gateway segment: the header, then every channel's request slots, then every
+// channel's response slots.
+class GatewayMapping {
+public:
+    // Creates a fresh segment (gateway side), retiring any previous one (see above). EBUSY,
+    // leaving it alone, if another live process is serving it.
+    int create(const std::string& name, size_t channels, size_t capacity) {
+        size_t slots = 2;
+        while(slots < capacity) slots <<= 1;
+        channels = std::clamp<size_t>(channels, 1, GATEWAY_MAX_CHANNELS);
+        size_t size = sizeof(GatewayHeader) + channels * slots * (sizeof(OrderRequest) + sizeof(OrderResponse));
+        uint32_t epoch = 1;
+        int err = segment.attach(name);
+        if(err && err != ENOENT && err != EPROTO) return err;
+        if(!err) {
+            GatewayHeader& h = head();
+            if(segment.size() >= sizeof(GatewayHeader) && h.magic == GATEWAY_MAGIC && h.version == GATEWAY_VERSION) {
+                int other = h.gateway_pid.load(std::memory_order_acquire);
+                if(other != 0 && other != getpid() && processAlive(other)) {
+                    segment.unmap();
+                    return EBUSY;
+                }
+                // unlinked first, so nobody re-opening on the new epoch can map this one
+                remove(name);
+                epoch = h.epoch.load(std::memory_order_relaxed) + 1;
+                h.epoch.store(epoch, std::memory_order_release);
+                h.request_bell.wakeAll();
+                for(uint32_t c = 0; c < std::min(h.channels, GATEWAY_MAX_CHANNELS); ++c) h.channel[c].response_bell.wakeAll();
+            }
+            segment.unmap();
+            remove(name);
+        }
+        bool resized = false;
+        err = segment.create(name, size, resized);
+        if(err) return err;
+        std::memset(segment.data(), 0, size);
+        GatewayHeader& h = head();
+        h.version = GATEWAY_VERSION;
+        h.channels = static_cast<uint32_t>(channels);
+        h.capacity = static_cast<uint32_t>(slots);
+        h.request_bytes = sizeof(OrderRequest);
+        h.response_bytes = sizeof(OrderResponse);
+        h.epoch.store(epoch, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        h.magic = GATEWAY_MAGIC;
+        this->epoch = epoch;
+        return 0;
+    }
+
+    // Maps an existing gateway (client side). ENOENT when it has not been created, EPROTO
+    // when it has another layout.
+    int attach(const std::string& name) {
+        int err = segment.attach(name);
+        if(err) return err;
+        const GatewayHeader& h = head();
+        if(segment.size() < sizeof(GatewayHeader) || h.magic != GATEWAY_MAGIC || h.version != GATEWAY_VERSION ||
+           h.request_bytes != sizeof(OrderRequest) || h.response_bytes != sizeof(OrderResponse) ||
+           h.channels == 0 || h.channels > GATEWAY_MAX_CHANNELS ||
+           sizeof(GatewayHeader) + size_t{h.channels} * h.capacity * (sizeof(OrderRequest) + sizeof(OrderResponse)) !=
+               segment.size()) {
+            segment.unmap();
+            return EPROTO;
+        }
+        epoch = h.epoch.load(std::memory_order_acquire);
+        return 0;
+    }
+
+    static void remove(const std::string& name) { ShmSegment::remove(name); }
+
+    bool mapped() const { return segment.mapped(); }
+    GatewayHeader& head() const { return *static_cast<GatewayHeader*>(segment.data()); }
+    // A restarted gateway has replaced this segment with a new one under the same name.
+    bool retired() const { return head().epoch.load(std::memory_order_acquire) != epoch; }
+    GatewayChannel& channel(size_t c) const { return head().channel[c]; }
+
+    SharedSpscRing<OrderRequest> requestRing(size_t c) const {
+        OrderRequest* slots = reinterpret_cast<OrderRequest*>(static_cast<char*>(segment.data()) + sizeof(GatewayHeader));
+        return {&channel(c).requests, slots + c * head().capacity, head().capacity};
+    }
+
+    SharedSpscRing<OrderResponse> responseRing(size_t c) const {
+        size_t requests = size_t{head().channels} * head().capacity;
+        OrderResponse* slots = reinterpret_cast<OrderResponse*>(static_cast<char*>(segment.data()) + sizeof(GatewayHeader) +
+                                                                requests * sizeof(OrderRequest));
+        return {&channel(c).responses, slots + c * head().capacity, head().capacity};
+    }
+
+private:
+    ShmSegment segment;
+    uint32_t epoch = 0;                // as of create/attach
+};
+
+// Size of a new gateway.
+struct GatewayConfig {
+    size_t channels = 4;
+    size_t capacity = 1024;            // slots per ring
+};
+
+// Execution side: serves every claimed channel from one thread.
+class OrderGateway {
+public:
+    static constexpr size_t BATCH = 32;                  // requests per channel per poll
+    static constexpr uint64_t REAP_EVERY = 1 << 16;      // polls between checks for dead clients
+
+    // EBUSY if another live process is serving this gateway. Clients of a previous one
+    // re-open on the new segment, with empty rings.
+    int open(const std::string& name, const GatewayConfig& config = GatewayConfig{}) {
+        int err = gw.create(name, config.channels, config.capacity);
+        if(err) return err;
+        gw.head().gateway_pid.store(getpid(), std::memory_order_release);
+        for(size_t c = 0; c < channels(); ++c) resetViews(c);
+        return 0;
+    }
+
+    // The segment outlives both sides; remove it once no process will use it again.
+    static void remove(const std::string& name) { GatewayMapping::remove(name); }
+
+    bool isOpen() const { return gw.mapped(); }
+    size_t channels() const { return gw.head().channels; }
+    size_t capacity() const { return gw.head().capacity; }
+
+    // Hands up to BATCH requests from each claimed channel to fn(channel, request); also
+    // resets channels their clients have closed. Returns the number of requests handled.
+    template<class Fn>
+    size_t poll(Fn&& fn) {
+        if(++polls % REAP_EVERY == 0) reap();
+        size_t handled = 0;
+        OrderRequest req;
+        for(size_t c = 0; c < channels(); ++c) {
+            uint32_t state = gw.channel(c).state.load(std::memory_order_acquire);
+            if(state == static_cast<uint32_t>(GatewayChannelState::Closing)) {
+                release(c);
+                continue;
+            }
+            if(state != static_cast<uint32_t>(GatewayChannelState::Claimed)) continue;
+            for(size_t n = 0; n < BATCH && requests[c].tryPop(req); ++n) {
+                fn(c, req);
+                ++handled;
+            }
+        }
+        return handled;
+    }
+
+    // Queues a response on the channel and wakes its client. False when the client has let
+    // its response ring fill up or has closed the channel. A gateway that answers later
+    // (fills of resting orders) should keep session(channel) with each order and drop the
+    // answer if the session has changed, as the channel then belongs to another client.
+    bool respond(size_t channel, const OrderResponse& response) {
+        if(gw.channel(channel).state.load(std::memory_order_acquire) != static_cast<uint32_t>(GatewayChannelState::Claimed) ||
+           !responses[channel].tryPush(response)) {
+            ++responses_dropped;
+            return false;
+        }
+        gw.channel(channel).response_bell.ring();
+        return true;
+    }
+
+    // Frees the channels of clients whose process has exited. poll() calls it every
+    // REAP_EVERY polls.
+    void reap() {
+        for(size_t c = 0; c < channels(); ++c) {
+            GatewayChannel& ch = gw.channel(c);
+            if(ch.state.load(std::memory_order_acquire) != static_cast<uint32_t>(GatewayChannelState::Claimed)) continue;
+            if(!processAlive(ch.pid.load(std::memory_order_relaxed))) release(c);
+        }
+    }
+
+    // Requests waiting or channels to reset: what ready() should check before park().
+    bool hasWork() const {
+        for(size_t c = 0; c < channels(); ++c) {
+            uint32_t state = gw.channel(c).state.load(std::memory_order_acquire);
+            if(state == static_cast<uint32_t>(GatewayChannelState::Closing)) return true;
+            if(state == static_cast<uint32_t>(GatewayChannelState::Claimed) && requests[c].depth() > 0) return true;
+        }
+        return false;
+    }
+
+    uint32_t session(size_t channel) const { return gw.channel(channel).session.load(std::memory_order_acquire); }
+
+    size_t clients() const {
+        size_t n = 0;
+        for(size_t c = 0; c < channels(); ++c) {
+            n += gw.channel(c).state.load(std::memory_order_acquire) == static_cast<uint32_t>(GatewayChannelState::Claimed);
+        }
+        return n;
+    }
+
+    // Parks until a client sends or closes, or interrupt() is called.
+    template<class Ready>
+    void park(Ready&& ready) {
+        gw.head().request_bell.park(ready);
+    }
+
+    void interrupt() const { gw.head().request_bell.wakeAll(); }
+
+    uint64_t responsesDropped() const { return responses_dropped; }
+
+private:
+    void resetViews(size_t c) {
+        requests[c] = gw.requestRing(c);
+        responses[c] = gw.responseRing(c);
+    }
+
+    void release(size_t c) {
+        GatewayChannel& ch = gw.channel(c);
+        ch.requests.head.store(0, std::memory_order_relaxed);
+        ch.requests.tail.store(0, std::memory_order_relaxed);
+        ch.responses.head.store(0, std::memory_order_relaxed);
+        ch.responses.tail.store(0, std::memory_order_relaxed);
+        ch.pid.store(0, std::memory_order_relaxed);
+        resetViews(c);
+        ch.state.store(static_cast<uint32_t>(GatewayChannelState::Free), std::memory_order_release);
+    }
+
+    GatewayMapping gw;
+    SharedSpscRing<OrderRequest> requests[GATEWAY_MAX_CHANNELS];
+    SharedSpscRing<OrderResponse> responses[GATEWAY_MAX_CHANNELS];
+    uint64_t polls = 0;
+    uint64_t responses_dropped = 0;
+};
+
+// Strategy side: one channel of a running gateway.
+class OrderGatewayClient {
+public:
+    OrderGatewayClient() = default;
+    OrderGatewayClient(const OrderGatewayClient&) = delete;
+    OrderGatewayClient& operator=(const OrderGatewayClient&) = delete;
+    ~OrderGatewayClient() { close(); }
+
+    // Attaches and claims a free channel. ENOENT: no such gateway; ECONNREFUSED: nobody is
+    // serving it; ENOSPC: every channel is taken.
+    int open(const std::string& gateway_name, const std::string& client_name) {
+        close();
+        GatewayMapping fresh;
+        int err = claim(fresh, gateway_name, client_name);
+        if(err) return err;
+        gw = std::move(fresh);
+        name = gateway_name;
+        client = client_name;
+        return 0;
+    }
+
+    // Hands the channel back; the gateway resets it on its next poll.
+    void close() {
+        if(!channel) return;
+        channel->state.store(static_cast<uint32_t>(GatewayChannelState::Closing), std::memory_order_release);
+        gw.head().request_bell.ring();
+        channel = nullptr;
+    }
+
+    bool isOpen() const { return channel != nullptr; }
+    size_t channelIndex() const { return index; }
+
+    // False when the request ring is full (the gateway is behind), or the gateway was
+    // restarted and the new one is not serving yet; nothing is queued.
+    bool send(const OrderRequest& request) {
+        if(gw.retired() && !reopen()) return false;
+        if(!requests.tryPush(request)) return false;
+        gw.head().request_bell.ring();
+        return true;
+    }
+
+    bool receive(OrderResponse& out) {
+        if(responses.tryPop(out)) return true;
+        if(gw.retired()) reopen();
+        return false;
+    }
+
+    size_t pendingResponses() const { return responses.depth(); }
+
+    // Parks until the gateway responds (or interrupt() is called). Never parks on a
+    // retired gateway, whose bells nobody rings any more.
+    template<class Ready>
+    void park(Ready&& ready) {
+        channel->response_bell.park([&] { return gw.retired() || ready(); });
+    }
+
+    void interrupt() const {
+        if(channel) channel->response_bell.wakeAll();
+    }
+
+    // Times the client moved to a restarted gateway.
+    uint64_t reconnects() const { return reopens; }
+
+private:
+    // Claims a channel of the gateway called gateway_name, mapped into m.
+    int claim(GatewayMapping& m, const std::string& gateway_name, const std::string& client_name) {
+        int err = m.attach(gateway_name);
+        if(err) return err;
+        int server = m.head().gateway_pid.load(std::memory_order_acquire);
+        if(server == 0 || !processAlive(server)) return ECONNREFUSED;
+        for(size_t c = 0; c < m.head().channels; ++c) {
+            GatewayChannel& ch = m.channel(c);
+            uint32_t expected = static_cast<uint32_t>(GatewayChannelState::Free);
+            if(!ch.state.compare_exchange_strong(expected, static_cast<uint32_t>(GatewayChannelState::Claimed))) continue;
+            std::memset(ch.name, 0, sizeof(ch.name));
+            std::memcpy(ch.name, client_name.data(), std::min(client_name.size(), sizeof(ch.name) - 1));
+            ch.pid.store(getpid(), std::memory_order_relaxed);
+            ch.session.fetch_add(1, std::memory_order_release);
+            requests = m.requestRing(c);
+            responses = m.responseRing(c);
+            channel = &ch;
+            index = c;
+            return 0;
+        }
+        return ENOSPC;
+    }
+
+    // Moves to the segment of a restarted gateway. The old channel is simply dropped:
+    // nobody serves it any more.
+    bool reopen() {
+        GatewayMapping fresh;
+        if(claim(fresh, name, client) != 0) return false;
+        gw = std::move(fresh);
+        ++reopens;
+        return true;
+    }
+
+    GatewayMapping gw;
+    GatewayChannel* channel = nullptr;
+    size_t index = 0;
+    SharedSpscRing<OrderRequest> requests;
+    SharedSpscRing<OrderResponse> responses;
+    std::string name;
+    std::string client;
+    uint64_t reopens = 0;
+};
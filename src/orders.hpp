@@ -0,0 +1,237 @@
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+#include <ostream>
+#include <vector>
+
+#include "fixed_point.hpp"
+#include "object_pool.hpp"
+#include "symbol_table.hpp"
+
+// Paper order flow for the market maker: resting orders, fills, market ticks and internal
+// events, all drawn from preallocated pools so placing, cancelling and filling an order
+// never touches the heap. There is no broker connection yet; PaperExchange fills a resting
+// order when a later tick trades through its price.
+
+enum class Side : uint8_t { Buy, Sell };
+
+struct Order {
+    uint64_t id = 0;
+    SymbolId symbol = INVALID_SYMBOL;
+    Side side = Side::Buy;
+    Price price;
+    int64_t qty = 0;
+    int64_t placed_ns = 0;
+    bool routed = false;             // the router took its OrderNew, so its cancel goes there too
+};
+
+struct Fill {
+    uint64_t order_id = 0;
+    SymbolId symbol = INVALID_SYMBOL;
+    Side side = Side::Buy;
+    Price price;
+    int64_t qty = 0;
+    int64_t ns = 0;
+};
+
+// Trade price seen in a poll; queued until the next matching pass.
+struct Tick {
+    Tick* next = nullptr;
+    SymbolId symbol = INVALID_SYMBOL;
+    Price last;
+    int64_t ns = 0;
+};
+
+enum class EventKind : uint8_t { OrderNew, OrderCancel, OrderFill };
+
+struct Event {
+    Event* next = nullptr;
+    EventKind kind = EventKind::OrderNew;
+    SymbolId symbol = INVALID_SYMBOL;
+    Side side = Side::Buy;
+    Price price;
+    int64_t qty = 0;
+};
+
+// Receives paper orders as they are placed and cancelled (an order gateway connection).
+// route() returns false when it could not pass the order on.
+class OrderRouter {
+public:
+    virtual ~OrderRouter() = default;
+    virtual bool route(EventKind kind, const Order& o) = 0;
+};
+
+// Pool capacities, fixed at startup. Defaults scale with the watchlist: two resting orders
+// per symbol plus the replacements placed while the old ones are cancelled, one tick per
+// symbol per poll. HFT_POOL_ORDERS / _FILLS / _TICKS / _EVENTS override each size.
+struct PoolConfig {
+    size_t orders = 0;
+    size_t fills = 0;
+    size_t ticks = 0;
+    size_t events = 0;
+
+    static PoolConfig forSymbols(size_t symbols) {
+        PoolConfig c;
+        c.orders = envSize("HFT_POOL_ORDERS", 4 * symbols);
+        c.fills = envSize("HFT_POOL_FILLS", 2 * symbols);
+        c.ticks = envSize("HFT_POOL_TICKS", 2 * symbols);
+        c.events = envSize("HFT_POOL_EVENTS", 8 * symbols);
+        return c;
+    }
+
+private:
+    static size_t envSize(const char* name, size_t fallback) {
+        const char* v = std::getenv(name);
+        if(!v || !*v) return fallback;
+        char* end = nullptr;
+        unsigned long long n = std::strtoull(v, &end, 10);
+        return *end == '\0' ? static_cast<size_t>(n) : fallback;
+    }
+};
+
+class PaperExchange {
+public:
+    explicit PaperExchange(const PoolConfig& config = PoolConfig{}, size_t symbols = 0)
+        : orders(config.orders), fills(config.fills), ticks(config.ticks), events(config.events),
+          resting_bid(symbols, nullptr), resting_ask(symbols, nullptr) {}
+
+    // Queues a trade price for the next match() pass. Dropped (and counted) when the tick
+    // pool is exhausted.
+    void onTick(SymbolId id, Price last, int64_t now_ns) {
+        Tick* t = ticks.acquire();
+        if(!t) return;
+        t->symbol = id;
+        t->last = last;
+        t->ns = now_ns;
+        if(tick_tail) tick_tail->next = t;
+        else tick_head = t;
+        tick_tail = t;
+    }
+
+    // Fills resting orders the queued ticks traded through (buy at or above the trade, sell
+    // at or below) and hands each fill to onFill before returning it to the pool. A fill is
+    // never lost: with the pool exhausted (counted in fillStats) it is passed from the stack.
+    template<class OnFill>
+    void match(OnFill&& onFill) {
+        while(Tick* t = tick_head) {
+            tick_head = t->next;
+            if(t->symbol < resting_bid.size()) {
+                Order*& bid = resting_bid[t->symbol];
+                if(bid && t->last <= bid->price) fill(bid, t->ns, onFill);
+                Order*& ask = resting_ask[t->symbol];
+                if(ask && t->last >= ask->price) fill(ask, t->ns, onFill);
+            }
+            ticks.release(t);
+        }
+        tick_tail = nullptr;
+    }
+
+    // Cancels every resting order and rests a new bid/ask at the table's computed quotes.
+    void requote(const SymbolStateTable& table, int64_t now_ns) {
+        for(SymbolId id = 0; id < table.size() && id < resting_bid.size(); ++id) {
+            cancel(resting_bid[id]);
+            cancel(resting_ask[id]);
+            if(table.our_bid[id] <= 0 || table.order_size[id] <= 0) continue;
+            resting_bid[id] = place(id, Side::Buy, Price{table.our_bid[id]}, table.order_size[id], now_ns);
+            resting_ask[id] = place(id, Side::Sell, Price{table.our_ask[id]}, table.order_size[id], now_ns);
+        }
+    }
+
+    // Hands queued events to fn in order and returns them to the pool. Returns how many
+    // events were dropped since the last drain because the event pool was exhausted; the
+    // orders themselves were placed, cancelled or filled all the same.
+    template<class Fn>
+    uint64_t drainEvents(Fn&& fn) {
+        while(Event* e = event_head) {
+            event_head = e->next;
+            fn(*e);
+            events.release(e);
+        }
+        event_tail = nullptr;
+        uint64_t dropped = events_dropped;
+        events_dropped = 0;
+        return dropped;
+    }
+
+    // Every order placed from now on, and the cancel of each one it accepted, is also
+    // handed to router as it happens (nullptr: orders stay on paper).
+    void setRouter(OrderRouter* r) { router = r; }
+
+    PoolStats orderStats() const { return orders.stats(); }
+    PoolStats fillStats() const { return fills.stats(); }
+    PoolStats tickStats() const { return ticks.stats(); }
+    PoolStats eventStats() const { return events.stats(); }
+
+    // fn(data, bytes) for the pools and the resting-order index (NUMA placement).
+    template<class Fn>
+    void memoryBlocks(Fn&& fn) {
+        orders.memoryBlocks(fn);
+        fills.memoryBlocks(fn);
+        ticks.memoryBlocks(fn);
+        events.memoryBlocks(fn);
+        fn(resting_bid.data(), resting_bid.size() * sizeof(Order*));
+        fn(resting_ask.data(), resting_ask.size() * sizeof(Order*));
+    }
+
+private:
+    Order* place(SymbolId id, Side side, Price price, int64_t qty, int64_t now_ns) {
+        Order* o = orders.acquire(Order{++next_order_id, id, side, price, qty, now_ns});
+        if(!o) return nullptr;
+        emit(EventKind::OrderNew, *o);
+        if(router) o->routed = router->route(EventKind::OrderNew, *o);
+        return o;
+    }
+
+    void cancel(Order*& o) {
+        if(!o) return;
+        emit(EventKind::OrderCancel, *o);
+        if(o->routed) router->route(EventKind::OrderCancel, *o);
+        orders.release(o);
+        o = nullptr;
+    }
+
+    template<class OnFill>
+    void fill(Order*& o, int64_t now_ns, OnFill& onFill) {
+        Fill spill{o->id, o->symbol, o->side, o->price, o->qty, now_ns};
+        Fill* f = fills.acquire(spill);
+        emit(EventKind::OrderFill, *o);
+        onFill(f ? *f : spill);
+        if(f) fills.release(f);
+        orders.release(o);
+        o = nullptr;
+    }
+
+    void emit(EventKind kind, const Order& o) {
+        Event* e = events.acquire();
+        if(!e) {
+            ++events_dropped;
+            return;
+        }
+        e->kind = kind;
+        e->symbol = o.symbol;
+        e->side = o.side;
+        e->price = o.price;
+        e->qty = o.qty;
+        if(event_tail) event_tail->next = e;
+        else event_head = e;
+        event_tail = e;
+    }
+
+    ObjectPool<Order> orders;
+    ObjectPool<Fill> fills;
+    ObjectPool<Tick> ticks;
+    ObjectPool<Event> events;
+    std::vector<Order*> resting_bid;  // indexed by SymbolId
+    std::vector<Order*> resting_ask;
+    Tick* tick_head = nullptr;
+    Tick* tick_tail = nullptr;
+    Event* event_head = nullptr;
+    Event* event_tail = nullptr;
+    uint64_t events_dropped = 0;     // since the last drainEvents
+    OrderRouter* router = nullptr;
+    uint64_t next_order_id = 0;
+};
+
+inline std::ostream& operator<<(std::ostream& os, const PoolStats& s) {
+    return os << s.in_use << "/" << s.capacity << " (high " << s.high_water << ", exhausted " << s.exhausted << ")";
+}
@@ -0,0 +1,175 @@
+#pragma once
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Low-jitter memory setup. Page faults and TLB misses on first touch show up as latency
+// spikes early in the run, so in low-jitter mode (HFT_LOW_JITTER=1) startup:
+//   - maps one region for the long-lived preallocated structures (pools, arenas, state
+//     columns, rings), backed by 2MB pages: explicit hugetlbfs pages when the system has
+//     them reserved, otherwise transparent huge pages via madvise, otherwise plain pages;
+//   - prefaults the whole region before the trading loop starts;
+//   - locks current and future memory with mlockall so nothing is paged out.
+// On a NUMA box the region is bound to one node (the strategy thread's) before it is
+// prefaulted; see numa.hpp for placing the structures outside it.
+// AlignedArray carves its storage from the region while it has room and falls back to the
+// heap otherwise, so callers do not change.
+
+constexpr size_t HUGE_PAGE = 2 * 1024 * 1024;
+constexpr size_t SMALL_PAGE = 4096;
+
+enum class PageBacking : uint8_t { None, HugeTlb, TransparentHuge, Small };
+
+inline const char* toString(PageBacking b) {
+    switch(b) {
+        case PageBacking::HugeTlb: return "2MB hugetlb pages";
+        case PageBacking::TransparentHuge: return "transparent huge pages";
+        case PageBacking::Small: return "4KB pages";
+        default: return "heap";
+    }
+}
+
+// Touches one byte per page so the kernel maps every page now rather than on first use.
+inline void prefault(void* p, size_t bytes) {
+    volatile char* c = static_cast<volatile char*>(p);
+    for(size_t off = 0; off < bytes; off += SMALL_PAGE) c[off] = c[off];
+}
+
+// Faults in the next `bytes` of the calling thread's stack. Not inlined, so the alloca
+// frame is popped again on return.
+[[gnu::noinline]] inline void prefaultStack(size_t bytes = 256 * 1024) {
+    volatile char* frame = static_cast<volatile char*>(__builtin_alloca(bytes));
+    for(size_t off = 0; off < bytes; off += SMALL_PAGE) frame[off] = 0;
+}
+
+// Prefers NUMA node `node` for the pages of [p, p + bytes), widened to whole pages, and
+// migrates the ones already faulted in (mbind MPOL_PREFERRED with MPOL_MF_MOVE, straight
+// through the syscall, so no libnuma). Returns 0 or the error number; ENOSYS on kernels
+// without NUMA support.
+inline int bindToNode(void* p, size_t bytes, int node) {
+    if(!p || bytes == 0 || node < 0 || node >= 1024) return EINVAL;
+    uintptr_t start = reinterpret_cast<uintptr_t>(p) & ~(SMALL_PAGE - 1);
+    uintptr_t end = (reinterpret_cast<uintptr_t>(p) + bytes + SMALL_PAGE - 1) & ~(SMALL_PAGE - 1);
+    unsigned long mask[1024 / 64] = {};
+    mask[node / 64] = 1ul << (node % 64);
+    long rc = syscall(SYS_mbind, start, end - start, MPOL_PREFERRED, mask, static_cast<unsigned long>(node / 64 + 1) * 64 + 1,
+                      MPOL_MF_MOVE);
+    return rc == 0 ? 0 : errno;
+}
+
+// Process-wide bump region for preallocated structures. Memory is never returned to it;
+// everything placed here lives for the process.
+class HugePageRegion {
+public:
+    static HugePageRegion& instance() {
+        static HugePageRegion region;
+        return region;
+    }
+
+    // Maps and prefaults `bytes` (rounded up to 2MB), on NUMA node `node` when one is given.
+    // Call once, before the structures that should live in it are built.
+    PageBacking reserve(size_t bytes, int node = -1) {
+        if(base || bytes == 0) return kind;
+        size_t size = (bytes + HUGE_PAGE - 1) / HUGE_PAGE * HUGE_PAGE;
+        void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        PageBacking backing = PageBacking::HugeTlb;
+        if(p == MAP_FAILED) {
+            // Over-map so the region can start on a 2MB boundary, which THP needs
+            size_t span = size + HUGE_PAGE;
+            p = mmap(nullptr, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if(p == MAP_FAILED) return kind;
+            uintptr_t start = (reinterpret_cast<uintptr_t>(p) + HUGE_PAGE - 1) & ~(HUGE_PAGE - 1);
+            size_t head = start - reinterpret_cast<uintptr_t>(p);
+            if(head) munmap(p, head);
+            if(span - head > size) munmap(reinterpret_cast<char*>(start) + size, span - head - size);
+            p = reinterpret_cast<void*>(start);
+            backing = madvise(p, size, MADV_HUGEPAGE) == 0 ? PageBacking::TransparentHuge : PageBacking::Small;
+        }
+        if(node >= 0) bindToNode(p, size, node);
+        prefault(p, size);
+        base = static_cast<char*>(p);
+        capacity = size;
+        kind = backing;
+        return kind;
+    }
+
+    // Aligned bump allocation; nullptr when no region is reserved or it is full.
+    void* allocate(size_t bytes, size_t align) {
+        if(!base) return nullptr;
+        size_t off = offset.load(std::memory_order_relaxed);
+        for(;;) {
+            size_t start = (off + align - 1) & ~(align - 1);
+            if(start + bytes > capacity) return nullptr;
+            if(offset.compare_exchange_weak(off, start + bytes, std::memory_order_relaxed)) return base + start;
+        }
+    }
+
+    bool contains(const void* p) const {
+        const char* c = static_cast<const char*>(p);
+        return base && c >= base && c < base + capacity;
+    }
+
+    PageBacking backing() const { return kind; }
+    size_t size() const { return capacity; }
+    size_t used() const { return offset.load(std::memory_order_relaxed); }
+
+private:
+    HugePageRegion() = default;
+
+    char* base = nullptr;
+    size_t capacity = 0;
+    std::atomic<size_t> offset{0};
+    PageBacking kind = PageBacking::None;
+};
+
+// Minor (no I/O) and major page faults taken by the calling thread so far.
+struct PageFaults {
+    long minor = 0;
+    long major = 0;
+
+    static PageFaults thisThread() {
+        rusage ru{};
+        getrusage(RUSAGE_THREAD, &ru);
+        return PageFaults{ru.ru_minflt, ru.ru_majflt};
+    }
+    PageFaults operator-(const PageFaults& o) const { return PageFaults{minor - o.minor, major - o.major}; }
+};
+
+struct LowJitterReport {
+    bool enabled = false;
+    PageBacking backing = PageBacking::None;
+    size_t region_bytes = 0;
+    int node = -1;                     // NUMA node the region is bound to, -1: none
+    bool locked = false;
+    int lock_errno = 0;
+};
+
+// True when HFT_LOW_JITTER is set to anything but "0".
+inline bool lowJitterRequested() {
+    const char* v = std::getenv("HFT_LOW_JITTER");
+    return v && *v && std::strcmp(v, "0") != 0;
+}
+
+// Startup half of low-jitter mode: reserve and prefault the region (HFT_HUGE_REGION_MB,
+// default 16) on `node` if given, and lock memory. mlockall failing (no CAP_IPC_LOCK, RLIMIT_MEMLOCK too low)
+// is reported, not fatal.
+inline LowJitterReport enterLowJitterMode(int node = -1) {
+    LowJitterReport r;
+    r.enabled = true;
+    size_t mb = 16;
+    if(const char* v = std::getenv("HFT_HUGE_REGION_MB")) mb = static_cast<size_t>(std::strtoull(v, nullptr, 10));
+    r.backing = HugePageRegion::instance().reserve(mb * 1024 * 1024, node);
+    r.region_bytes = HugePageRegion::instance().size();
+    r.node = node;
+    r.locked = mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+    r.lock_errno = r.locked ? 0 : errno;
+    return r;
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+#include "json_scan.hpp"
+
+// Fixed-schema GLOBAL_QUOTE parser.
+// Alpha Vantage returns
+//   { "Global Quote": { "01. symbol": "IBM", "02. open": "226.6000", ..., "10. change percent": "0.6239%" } }
+// Every key carries its field number as a two digit prefix, so we walk the object once
+// and slot each value by that prefix. Values are views into the response buffer: nothing
+// is copied and nothing is allocated.
+
+enum class QuoteField : uint8_t {
+    Symbol,
+    Open,
+    High,
+    Low,
+    Price,
+    Volume,
+    LatestTradingDay,
+    PreviousClose,
+    Change,
+    ChangePercent,
+    Count
+};
+
+struct GlobalQuote {
+    std::string_view fields[static_cast<int>(QuoteField::Count)];
+    uint16_t present = 0;  // bit i set when field i was seen
+
+    std::string_view operator[](QuoteField f) const { return fields[static_cast<int>(f)]; }
+    bool has(QuoteField f) const { return present & (1u << static_cast<int>(f)); }
+    bool complete() const { return present == (1u << static_cast<int>(QuoteField::Count)) - 1; }
+};
+
+// Returns false when the response has no "Global Quote" object (API error, rate limit note)
+// or the object is malformed. Unknown keys are skipped. Only structural characters are
+// visited, so whitespace between tokens never gets looked at byte-by-byte.
+inline bool parseGlobalQuote(std::string_view body, GlobalQuote& out, const JsonScanner& scan = jsonScanner()) {
+    out = GlobalQuote{};
+
+    size_t objPos = body.find("\"Global Quote\"");
+    if(objPos == std::string_view::npos) return false;
+
+    const char* end = body.data() + body.size();
+    StructuralCursor cur(body.data() + objPos + 14, end, scan);
+    const char* p = cur.next();
+    if(p == end || *p != ':') return false;
+    p = cur.next();
+    if(p == end || *p != '{') return false;
+
+    for(;;) {
+        p = cur.next();
+        if(p == end) return false;
+        if(*p == '}') return true;
+        if(*p != '"') return false;
+
+        // key: "NN. name"
+        const char* key = p + 1;
+        const char* keyEnd = cur.stringEnd();
+        if(keyEnd == end) return false;
+
+        p = cur.next();
+        if(p == end || *p != ':') return false;
+        p = cur.next();
+        if(p == end || *p != '"') return false;
+
+        const char* value = p + 1;
+        const char* valueEnd = cur.stringEnd();
+        if(valueEnd == end) return false;
+
+        if(keyEnd - key > 3 && key[2] == '.') {
+            unsigned d0 = static_cast<unsigned>(key[0] - '0');
+            unsigned d1 = static_cast<unsigned>(key[1] - '0');
+            unsigned idx = d0 * 10 + d1 - 1;
+            if(d0 < 10 && d1 < 10 && idx < static_cast<unsigned>(QuoteField::Count)) {
+                out.fields[idx] = std::string_view(value, static_cast<size_t>(valueEnd - value));
+                out.present |= static_cast<uint16_t>(1u << idx);
+            }
+        }
+
+        p = cur.next();
+        if(p == end) return false;
+        if(*p == '}') return true;
+        if(*p != ',') return false;
+    }
+}
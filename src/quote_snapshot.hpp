@@ -0,0 +1,17 @@
+#pragma once
+#include <cstdint>
+
+#include "fixed_point.hpp"
+#include "seqlock.hpp"
+
+// Market view of one symbol, published as a unit so readers never see the last price of
+// one update next to the bid/ask of another. Seqlock<QuoteSnapshot> is a single cache line.
+struct QuoteSnapshot {
+    Price last;
+    Price bid;
+    Price ask;
+    int64_t volume = 0;
+    int64_t updated_ns = 0;  // steady_clock time of the update
+};
+
+static_assert(sizeof(Seqlock<QuoteSnapshot>) == 64, "quote snapshot should fit one cache line");
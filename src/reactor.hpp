@@ -0,0 +1,225 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <vector>
+
+#include "execution.hpp"
+
+// Single-threaded readiness reactor on epoll.
+// File descriptors (sockets, timerfds, eventfds) are registered with a handler that runs on
+// the reactor thread whenever the fd is ready; nothing in the loop sleeps or blocks except
+// epoll_wait itself. stop() and wake() are safe from any thread: they signal an internal
+// eventfd that the loop always watches. How the loop waits for readiness follows the
+// execution WaitMode: block in epoll_wait (sleep), poll with a zero timeout for a short
+// window before blocking (hybrid), or never block (spin).
+
+// Non-blocking eventfd counter, used for cross-thread wake-ups and command mailboxes.
+class EventFd {
+public:
+    EventFd() : handle(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {}
+    EventFd(const EventFd&) = delete;
+    EventFd& operator=(const EventFd&) = delete;
+    ~EventFd() { if(handle >= 0) close(handle); }
+
+    int fd() const { return handle; }
+    void signal(uint64_t n = 1) {
+        ssize_t r = write(handle, &n, sizeof(n));
+        (void)r;
+    }
+    // Returns and clears the count (0 when nothing was signalled).
+    uint64_t drain() {
+        uint64_t n = 0;
+        return read(handle, &n, sizeof(n)) == sizeof(n) ? n : 0;
+    }
+
+private:
+    int handle;
+};
+
+// Monotonic-clock timerfd.
+class TimerFd {
+public:
+    TimerFd() : handle(timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)) {}
+    TimerFd(const TimerFd&) = delete;
+    TimerFd& operator=(const TimerFd&) = delete;
+    ~TimerFd() { if(handle >= 0) close(handle); }
+
+    int fd() const { return handle; }
+
+    // Fires once after `first` (a zero delay fires immediately), then every `interval`
+    // if that is non-zero.
+    void arm(std::chrono::nanoseconds first, std::chrono::nanoseconds interval = std::chrono::nanoseconds(0)) {
+        itimerspec spec{};
+        spec.it_value = toTimespec(first.count() > 0 ? first : std::chrono::nanoseconds(1));
+        spec.it_interval = toTimespec(interval);
+        timerfd_settime(handle, 0, &spec, nullptr);
+    }
+    void disarm() {
+        itimerspec spec{};
+        timerfd_settime(handle, 0, &spec, nullptr);
+    }
+    // Expirations since the last drain.
+    uint64_t drain() {
+        uint64_t n = 0;
+        return read(handle, &n, sizeof(n)) == sizeof(n) ? n : 0;
+    }
+
+private:
+    static timespec toTimespec(std::chrono::nanoseconds ns) {
+        timespec ts{};
+        ts.tv_sec = static_cast<time_t>(ns.count() / 1'000'000'000);
+        ts.tv_nsec = static_cast<long>(ns.count() % 1'000'000'000);
+        return ts;
+    }
+
+    int handle;
+};
+
+// Signals taken as fd readiness instead of by a handler. The constructor blocks them in the
+// calling thread, and threads started afterwards inherit that, so construct it in main()
+// before any thread starts.
+class SignalFd {
+public:
+    explicit SignalFd(std::initializer_list<int> signals) {
+        sigemptyset(&mask);
+        for(int s : signals) sigaddset(&mask, s);
+        pthread_sigmask(SIG_BLOCK, &mask, nullptr);
+        handle = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    }
+    SignalFd(const SignalFd&) = delete;
+    SignalFd& operator=(const SignalFd&) = delete;
+    ~SignalFd() { if(handle >= 0) close(handle); }
+
+    int fd() const { return handle; }
+    // Next pending signal number, 0 if none.
+    int take() {
+        signalfd_siginfo info{};
+        return read(handle, &info, sizeof(info)) == sizeof(info) ? static_cast<int>(info.ssi_signo) : 0;
+    }
+
+private:
+    sigset_t mask;
+    int handle = -1;
+};
+
+class Reactor {
+public:
+    using Handler = std::function<void(uint32_t events)>;
+
+    static constexpr int MAX_EVENTS = 64;
+    static constexpr int HYBRID_POLLS = 2'000;
+
+    Reactor() : epfd(epoll_create1(EPOLL_CLOEXEC)) {
+        add(wakeup.fd(), EPOLLIN, [this](uint32_t) { wakeup.drain(); });
+    }
+    Reactor(const Reactor&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+    ~Reactor() { if(epfd >= 0) close(epfd); }
+
+    // Registers fd; false if it is already registered or epoll refuses it.
+    bool add(int fd, uint32_t events, Handler handler) {
+        if(fd < 0 || registered(fd)) return false;
+        epoll_event ev{};
+        ev.events = events;
+        ev.data.fd = fd;
+        if(epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev) != 0) return false;
+        if(static_cast<size_t>(fd) >= handlers.size()) handlers.resize(static_cast<size_t>(fd) + 1);
+        // Handler nodes are recycled, so sockets that come and go on every request do not
+        // allocate once the loop is warm
+        std::unique_ptr<Handler> node;
+        if(spare.empty()) {
+            node = std::make_unique<Handler>(std::move(handler));
+        } else {
+            node = std::move(spare.back());
+            spare.pop_back();
+            *node = std::move(handler);
+        }
+        handlers[static_cast<size_t>(fd)] = std::move(node);
+        return true;
+    }
+
+    bool modify(int fd, uint32_t events) {
+        if(!registered(fd)) return false;
+        epoll_event ev{};
+        ev.events = events;
+        ev.data.fd = fd;
+        return epoll_ctl(epfd, EPOLL_CTL_MOD, fd, &ev) == 0;
+    }
+
+    // Safe from inside a handler, including the fd's own: the handler is destroyed only
+    // after the current dispatch batch.
+    void remove(int fd) {
+        if(!registered(fd)) return;
+        epoll_ctl(epfd, EPOLL_CTL_DEL, fd, nullptr);  // may already be gone if fd was closed
+        retired.push_back(std::move(handlers[static_cast<size_t>(fd)]));
+    }
+
+    bool registered(int fd) const {
+        return fd >= 0 && static_cast<size_t>(fd) < handlers.size() && handlers[static_cast<size_t>(fd)] != nullptr;
+    }
+
+    // One epoll_wait (timeout in ms, -1 blocks) and dispatch. Returns the number of ready fds.
+    int runOnce(int timeout_ms) {
+        epoll_event events[MAX_EVENTS];
+        int n = epoll_wait(epfd, events, MAX_EVENTS, timeout_ms);
+        for(int i = 0; i < n; ++i) {
+            int fd = events[i].data.fd;
+            // A handler earlier in this batch may have removed fd
+            if(!registered(fd)) continue;
+            // Handlers live in their own nodes, so add() growing the table is safe here
+            Handler* h = handlers[static_cast<size_t>(fd)].get();
+            (*h)(events[i].events);
+        }
+        recycle();
+        return n > 0 ? n : 0;
+    }
+
+    // Dispatches until stop().
+    void run(WaitMode mode = WaitMode::Sleep) {
+        int idle = 0;
+        while(!stopping.load(std::memory_order_acquire)) {
+            int timeout = -1;
+            if(mode == WaitMode::Spin || (mode == WaitMode::Hybrid && idle < HYBRID_POLLS)) timeout = 0;
+            if(runOnce(timeout) > 0) {
+                idle = 0;
+            } else if(timeout == 0) {
+                ++idle;
+                cpuRelax();
+            }
+        }
+    }
+
+    // Thread-safe.
+    void stop() {
+        stopping.store(true, std::memory_order_release);
+        wakeup.signal();
+    }
+    void wake() { wakeup.signal(); }
+    bool stopped() const { return stopping.load(std::memory_order_acquire); }
+
+private:
+    void recycle() {
+        for(std::unique_ptr<Handler>& node : retired) {
+            *node = nullptr;
+            spare.push_back(std::move(node));
+        }
+        retired.clear();
+    }
+
+    int epfd;
+    EventFd wakeup;
+    std::atomic<bool> stopping{false};
+    std::vector<std::unique_ptr<Handler>> handlers;  // indexed by fd
+    std::vector<std::unique_ptr<Handler>> retired;   // removed during the current batch
+    std::vector<std::unique_ptr<Handler>> spare;     // empty nodes for add()
+};
@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Single-writer sequence lock.
+// The writer bumps the sequence to odd, stores the payload, then bumps it to even; a reader
+// copies the payload between two sequence loads and retries if they differ or are odd. The
+// writer never waits on readers and readers never write shared state, so any number of
+// readers can poll without bouncing the cache line between them. The payload is held as
+// relaxed atomic words so the racy copy is well defined.
+
+template<class T>
+class alignas(64) Seqlock {
+    static_assert(std::is_trivially_copyable_v<T>, "Seqlock payload must be trivially copyable");
+    static constexpr size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+public:
+    Seqlock() : Seqlock(T{}) {}
+    explicit Seqlock(const T& initial) { store(initial); }
+
+    // Writer side. Must only be called from one thread at a time.
+    void store(const T& value) {
+        uint64_t buf[WORDS] = {};
+        std::memcpy(buf, &value, sizeof(T));
+
+        uint64_t s = seq.load(std::memory_order_relaxed);
+        seq.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for(size_t i = 0; i < WORDS; ++i) words[i].store(buf[i], std::memory_order_relaxed);
+        seq.store(s + 2, std::memory_order_release);
+    }
+
+    // One attempt; false if a write overlapped the copy.
+    bool tryLoad(T& out) const {
+        uint64_t buf[WORDS];
+        uint64_t s0 = seq.load(std::memory_order_acquire);
+        if(s0 & 1) return false;
+        for(size_t i = 0; i < WORDS; ++i) buf[i] = words[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(seq.load(std::memory_order_relaxed) != s0) return false;
+        std::memcpy(&out, buf, sizeof(T));
+        return true;
+    }
+
+    // Consistent snapshot; retries only while a write is in progress.
+    T load() const {
+        T out;
+        while(!tryLoad(out)) {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#endif
+        }
+        return out;
+    }
+
+    // Number of completed writes.
+    uint64_t version() const { return seq.load(std::memory_order_acquire) / 2; }
+
+private:
+    std::atomic<uint64_t> seq{0};
+    std::atomic<uint64_t> words[WORDS];
+};
@@ -0,0 +1,195 @@
+#pragma once
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <type_traits>
+#include <utility>
+#include <unistd.h>
+
+#include "aligned.hpp"
+
+// Building blocks for structures shared between processes (market_bus.hpp,
+// order_gateway.hpp): a named POSIX shared-memory segment, a futex wake-up that works
+// across processes and an SPSC ring whose indices and slots live in a segment. Anything
+// placed in a segment must be plain data plus lock-free atomics, valid when zero-filled,
+// and refer to other parts of the segment by index, never by pointer, since each process
+// maps it at its own address.
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free,
+              "shared indices live in the mapping");
+
+// False once pid has exited (for reclaiming the slots of crashed peers).
+inline bool processAlive(int pid) { return kill(pid, 0) == 0 || errno != ESRCH; }
+
+// /dev/shm/<name>, mapped read-write and shared.
+class ShmSegment {
+public:
+    ShmSegment() = default;
+    ShmSegment(const ShmSegment&) = delete;
+    ShmSegment& operator=(const ShmSegment&) = delete;
+    ShmSegment(ShmSegment&& o) noexcept : base(o.base), bytes(o.bytes) {
+        o.base = nullptr;
+        o.bytes = 0;
+    }
+    ShmSegment& operator=(ShmSegment&& o) noexcept {
+        std::swap(base, o.base);
+        std::swap(bytes, o.bytes);
+        return *this;
+    }
+    ~ShmSegment() { unmap(); }
+
+    // Opens or creates the segment and sizes it to bytes. `resized` tells the caller the
+    // old contents (if any) had another size and are now zero or stale.
+    int create(const std::string& name, size_t bytes, bool& resized) {
+        unmap();
+        int fd = shm_open(path(name).c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if(fd < 0) return errno;
+        struct stat st{};
+        resized = fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) != bytes;
+        if(resized && ftruncate(fd, static_cast<off_t>(bytes)) != 0) return closeWith(fd, errno);
+        return mapFd(fd, bytes);
+    }
+
+    // Maps an existing segment at its current size; ENOENT when nobody has created it.
+    int attach(const std::string& name) {
+        unmap();
+        int fd = shm_open(path(name).c_str(), O_RDWR | O_CLOEXEC, 0);
+        if(fd < 0) return errno;
+        struct stat st{};
+        if(fstat(fd, &st) != 0) return closeWith(fd, errno);
+        if(st.st_size <= 0) return closeWith(fd, EPROTO);
+        return mapFd(fd, static_cast<size_t>(st.st_size));
+    }
+
+    void unmap() {
+        if(base) munmap(base, bytes);
+        base = nullptr;
+        bytes = 0;
+    }
+
+    static void remove(const std::string& name) { shm_unlink(path(name).c_str()); }
+
+    bool mapped() const { return base != nullptr; }
+    void* data() const { return base; }
+    size_t size() const { return bytes; }
+
+private:
+    static std::string path(const std::string& name) { return name.empty() || name[0] != '/' ? "/" + name : name; }
+
+    static int closeWith(int fd, int err) {
+        ::close(fd);
+        return err;
+    }
+
+    int mapFd(int fd, size_t size) {
+        void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        int err = p == MAP_FAILED ? errno : 0;
+        ::close(fd);
+        if(err) return err;
+        base = p;
+        bytes = size;
+        return 0;
+    }
+
+    void* base = nullptr;
+    size_t bytes = 0;
+};
+
+// Doorbell (execution.hpp) for threads in different processes: the same parked flag and
+// sequence, but waited on with a shared (non-private) futex, and any number of waiters.
+// ring() clears the flag as it wakes them all, so a burst of work costs one syscall, not
+// one per item. Lives in a ShmSegment; all zeros is a valid bell.
+struct SharedDoorbell {
+    std::atomic<uint32_t> seq;
+    std::atomic<uint32_t> parked;
+
+    void ring() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(parked.load(std::memory_order_relaxed) && parked.exchange(0, std::memory_order_relaxed)) wakeAll();
+    }
+
+    // Wakes every waiter whether or not one is parked (stop requests).
+    void wakeAll() {
+        seq.fetch_add(1, std::memory_order_release);
+        syscall(SYS_futex, &seq, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+    }
+
+    // As Doorbell::park: ready() must check everything that rings this bell.
+    template<class Ready>
+    void park(Ready&& ready) {
+        uint32_t seen = seq.load(std::memory_order_acquire);
+        parked.store(1, std::memory_order_seq_cst);
+        if(!ready()) syscall(SYS_futex, &seq, FUTEX_WAIT, seen, nullptr, nullptr, 0);
+    }
+};
+
+// Indices of a SharedSpscRing, kept in the segment next to its slots: the producer's tail
+// and the consumer's head, each on a cache line of its own.
+struct SharedRingIndices {
+    alignas(CACHE_LINE) std::atomic<uint64_t> tail;
+    alignas(CACHE_LINE) std::atomic<uint64_t> head;
+};
+
+// One process's end of an SPSC ring in shared memory; the same protocol as SpscRing,
+// including the cached copy of the other side's index, but never blocking: a full push
+// and an empty pop just fail. Each side builds its own view over the shared indices and
+// slots, and only calls its own half.
+template<class T>
+class SharedSpscRing {
+    static_assert(std::is_trivially_copyable_v<T>, "ring slots hold plain data");
+
+public:
+    SharedSpscRing() = default;
+    SharedSpscRing(SharedRingIndices* indices, T* slots, size_t capacity)
+        : idx(indices), data(slots), mask(capacity - 1),
+          head_cache(indices->head.load(std::memory_order_acquire)),
+          tail_cache(indices->tail.load(std::memory_order_acquire)) {}
+
+    // Producer side.
+    bool tryPush(const T& item) {
+        uint64_t t = idx->tail.load(std::memory_order_relaxed);
+        if(t - head_cache > mask) {
+            head_cache = idx->head.load(std::memory_order_acquire);
+            if(t - head_cache > mask) return false;
+        }
+        data[t & mask] = item;
+        idx->tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side.
+    bool tryPop(T& out) {
+        uint64_t h = idx->head.load(std::memory_order_relaxed);
+        if(h == tail_cache) {
+            tail_cache = idx->tail.load(std::memory_order_acquire);
+            if(h == tail_cache) return false;
+        }
+        out = data[h & mask];
+        idx->head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Either side.
+    size_t depth() const {
+        uint64_t h = idx->head.load(std::memory_order_acquire);
+        return static_cast<size_t>(idx->tail.load(std::memory_order_acquire) - h);
+    }
+
+    size_t capacity() const { return mask + 1; }
+
+private:
+    SharedRingIndices* idx = nullptr;
+    T* data = nullptr;
+    size_t mask = 0;
+    uint64_t head_cache = 0;           // producer's copy of head
+    uint64_t tail_cache = 0;           // consumer's copy of tail
+};
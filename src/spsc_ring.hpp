@@ -0,0 +1,160 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+#include "aligned.hpp"
+
+// Bounded single-producer/single-consumer ring.
+// The producer owns the tail index and the consumer the head index, each on its own cache
+// line together with a cached copy of the other side's index, so in the steady state a
+// push or pop touches only its own line plus the slot. Capacity is rounded up to a power
+// of two. Slots are plain data (see AlignedArray), so they land in the huge-page region in
+// low-jitter mode.
+//
+// What happens when the ring is full is the overflow policy:
+//   Block      the producer waits for room, so backpressure reaches the feed; close()
+//              from the consumer ends the wait
+//   DropNewest the push fails and is counted; the producer carries on
+// Depth high water, drops and producer waits are kept for reporting.
+
+enum class OverflowPolicy : uint8_t { Block, DropNewest };
+
+inline const char* toString(OverflowPolicy p) {
+    return p == OverflowPolicy::Block ? "block" : "drop-newest";
+}
+
+// HFT_RING_POLICY=block|drop, defaulting to block.
+inline OverflowPolicy defaultOverflowPolicy() {
+    const char* v = std::getenv("HFT_RING_POLICY");
+    return v && std::strcmp(v, "drop") == 0 ? OverflowPolicy::DropNewest : OverflowPolicy::Block;
+}
+
+// HFT_RING_CAPACITY, defaulting to 1024 slots.
+inline size_t defaultRingCapacity() {
+    const char* v = std::getenv("HFT_RING_CAPACITY");
+    size_t n = v ? static_cast<size_t>(std::strtoull(v, nullptr, 10)) : 0;
+    return n ? n : 1024;
+}
+
+struct RingStats {
+    size_t capacity = 0;
+    size_t depth = 0;
+    size_t high_water = 0;
+    uint64_t pushed = 0;
+    uint64_t dropped = 0;
+    uint64_t producer_waits = 0;  // pushes that found the ring full under Block
+};
+
+template<class T>
+class SpscRing {
+    static_assert(std::is_trivially_copyable_v<T>, "ring slots hold plain data");
+
+public:
+    explicit SpscRing(size_t capacity, OverflowPolicy policy = OverflowPolicy::Block)
+        : slots(roundUp(capacity)), mask(slots.size() - 1), overflow(policy) {}
+
+    // Producer side. Applies the overflow policy; false only when the item was dropped or
+    // the ring was closed while waiting for room.
+    bool push(const T& item) { return push(item, overflow); }
+
+    bool push(const T& item, OverflowPolicy policy) {
+        size_t t = prod.tail.load(std::memory_order_relaxed);
+        if(t - prod.head_cache == slots.size()) {
+            prod.head_cache = cons.head.load(std::memory_order_acquire);
+            if(t - prod.head_cache == slots.size()) {
+                if(policy == OverflowPolicy::DropNewest) {
+                    bump(prod.dropped);
+                    return false;
+                }
+                bump(prod.waits);
+                while(t - (prod.head_cache = cons.head.load(std::memory_order_acquire)) == slots.size()) {
+                    if(cons.closed.load(std::memory_order_acquire)) return false;
+                    std::this_thread::yield();
+                }
+            }
+        }
+        slots[t & mask] = item;
+        prod.tail.store(t + 1, std::memory_order_release);
+        bump(prod.pushed);
+        size_t depth = t + 1 - prod.head_cache;
+        if(depth > prod.high_water.load(std::memory_order_relaxed)) prod.high_water.store(depth, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Consumer side. False when empty.
+    bool pop(T& out) {
+        size_t h = cons.head.load(std::memory_order_relaxed);
+        if(h == cons.tail_cache) {
+            cons.tail_cache = prod.tail.load(std::memory_order_acquire);
+            if(h == cons.tail_cache) return false;
+        }
+        out = slots[h & mask];
+        cons.head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: the consumer is going away, so a producer blocked on a full ring gives
+    // up instead of waiting forever.
+    void close() { cons.closed.store(true, std::memory_order_release); }
+    bool closed() const { return cons.closed.load(std::memory_order_acquire); }
+
+    // Approximate from either side.
+    size_t depth() const {
+        return prod.tail.load(std::memory_order_acquire) - cons.head.load(std::memory_order_acquire);
+    }
+    size_t capacity() const { return slots.size(); }
+    OverflowPolicy policy() const { return overflow; }
+
+    // fn(data, bytes) for the slot array (NUMA placement).
+    template<class Fn>
+    void memoryBlocks(Fn&& fn) { fn(slots.data(), slots.bytes()); }
+
+    // Readable from either thread. The high water is measured against the producer's
+    // cached head, so it may overstate slightly.
+    RingStats stats() const {
+        RingStats s;
+        s.capacity = slots.size();
+        s.depth = depth();
+        s.high_water = prod.high_water.load(std::memory_order_relaxed);
+        s.pushed = prod.pushed.load(std::memory_order_relaxed);
+        s.dropped = prod.dropped.load(std::memory_order_relaxed);
+        s.producer_waits = prod.waits.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    // Single-writer counter: a plain load/store, no locked RMW.
+    template<class C>
+    static void bump(std::atomic<C>& c) { c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+
+    static size_t roundUp(size_t n) {
+        size_t c = 2;
+        while(c < n) c <<= 1;
+        return c;
+    }
+
+    struct alignas(CACHE_LINE) Producer {
+        std::atomic<size_t> tail{0};
+        size_t head_cache = 0;
+        std::atomic<size_t> high_water{0};
+        std::atomic<uint64_t> pushed{0};
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<uint64_t> waits{0};
+    };
+    struct alignas(CACHE_LINE) Consumer {
+        std::atomic<size_t> head{0};
+        size_t tail_cache = 0;
+        std::atomic<bool> closed{false};
+    };
+
+    AlignedArray<T> slots;
+    size_t mask;
+    OverflowPolicy overflow;
+    Producer prod;
+    Consumer cons;
+};
@@ -0,0 +1,172 @@
+#pragma once
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <string_view>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+
+#include "fixed_point.hpp"
+#include "market_data.hpp"
+
+// Versioned, memory-mapped state file for fast restarts.
+// Holds the portfolio, per-symbol positions and last quotes, and the request budget, so a
+// restarted process remaps the file and resumes quoting from the cached state instead of
+// re-polling everything under the API rate limit.
+//
+// Checkpoints are double-buffered: the file has two slots, a checkpoint fills the inactive
+// one and then bumps the header generation, whose low bit names the active slot. A process
+// that dies mid-checkpoint leaves the previous slot intact. The layout is plain data; any
+// change to it bumps STATE_VERSION, and a file with another magic, version or capacity is
+// reinitialized rather than misread. One process owns a file at a time: open() takes an
+// exclusive flock, held until close(), and reports Locked instead of sharing it.
+
+constexpr uint32_t STATE_MAGIC = 0x53544648;  // "HFTS"
+constexpr uint32_t STATE_VERSION = 1;
+constexpr uint32_t STATE_SYMBOL_CAPACITY = 256;
+
+struct PersistedSymbol {
+    char symbol[SYMBOL_CAPACITY];
+    int64_t last;      // ticks
+    int64_t bid;
+    int64_t ask;
+    int64_t volume;
+    int64_t position;  // signed shares
+
+    std::string_view symbolView() const { return std::string_view(symbol, strnlen(symbol, SYMBOL_CAPACITY)); }
+};
+
+// Request budget against the API rate limit.
+struct RequestBudget {
+    int32_t day = 0;                   // yyyymmdd (UTC) the count applies to
+    int32_t requests_today = 0;
+    int64_t last_request_unix_ms = 0;
+};
+
+struct StateSlot {
+    uint64_t generation;
+    int64_t saved_unix_ms;
+    Money cash;
+    int64_t shares;
+    RequestBudget budget;
+    uint32_t symbol_count;
+    uint32_t reserved;
+    PersistedSymbol symbols[STATE_SYMBOL_CAPACITY];
+};
+
+struct StateFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t symbol_capacity;
+    uint32_t slot_bytes;
+    std::atomic<uint64_t> generation;  // slots[generation & 1] is the latest checkpoint
+    char pad[40];
+};
+
+struct StateFileLayout {
+    StateFileHeader header;
+    StateSlot slots[2];
+};
+
+static_assert(std::is_trivially_copyable_v<StateSlot>, "state slots are copied as raw bytes");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "generation is shared through the mapping");
+
+class StateFile {
+public:
+    enum class OpenResult : uint8_t { Created, Restored, Reinitialized, Locked, Failed };
+
+    StateFile() = default;
+    StateFile(const StateFile&) = delete;
+    StateFile& operator=(const StateFile&) = delete;
+    ~StateFile() { close(); }
+
+    // Maps path, creating or reinitializing it when absent or incompatible. Locked, with
+    // nothing mapped, when another process holds the file.
+    OpenResult open(const std::string& path) {
+        close();
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if(fd < 0) return fail();
+        if(flock(fd, LOCK_EX | LOCK_NB) != 0) {
+            if(errno != EWOULDBLOCK) return fail();
+            close();
+            return OpenResult::Locked;
+        }
+        struct stat st{};
+        if(fstat(fd, &st) != 0) return fail();
+        bool fresh = static_cast<size_t>(st.st_size) != sizeof(StateFileLayout);
+        if(fresh && ftruncate(fd, sizeof(StateFileLayout)) != 0) return fail();
+
+        void* p = mmap(nullptr, sizeof(StateFileLayout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if(p == MAP_FAILED) return fail();
+        map = static_cast<StateFileLayout*>(p);
+
+        bool compatible = !fresh && map->header.magic == STATE_MAGIC && map->header.version == STATE_VERSION &&
+                          map->header.symbol_capacity == STATE_SYMBOL_CAPACITY &&
+                          map->header.slot_bytes == sizeof(StateSlot) &&
+                          latest()->generation == map->header.generation.load(std::memory_order_acquire);
+        if(compatible) return OpenResult::Restored;
+
+        std::memset(static_cast<void*>(map), 0, sizeof(StateFileLayout));
+        map->header.magic = STATE_MAGIC;
+        map->header.version = STATE_VERSION;
+        map->header.symbol_capacity = STATE_SYMBOL_CAPACITY;
+        map->header.slot_bytes = sizeof(StateSlot);
+        msync(map, sizeof(StateFileLayout), MS_ASYNC);
+        return fresh ? OpenResult::Created : OpenResult::Reinitialized;
+    }
+
+    bool isOpen() const { return map != nullptr; }
+    int error() const { return last_errno; }
+
+    // Latest complete checkpoint (generation 0: nothing saved yet).
+    const StateSlot* latest() const {
+        if(!map) return nullptr;
+        return &map->slots[map->header.generation.load(std::memory_order_acquire) & 1];
+    }
+
+    // Writes a checkpoint: fill(slot) populates the inactive slot, which is then published.
+    template<class Fill>
+    void checkpoint(Fill&& fill) {
+        if(!map) return;
+        uint64_t next = map->header.generation.load(std::memory_order_relaxed) + 1;
+        StateSlot& slot = map->slots[next & 1];
+        fill(slot);
+        slot.generation = next;
+        map->header.generation.store(next, std::memory_order_release);
+        msync(map, sizeof(StateFileLayout), MS_ASYNC);
+    }
+
+    void close() {
+        if(map) munmap(map, sizeof(StateFileLayout));
+        if(fd >= 0) ::close(fd);
+        map = nullptr;
+        fd = -1;
+    }
+
+private:
+    OpenResult fail() {
+        last_errno = errno;
+        close();
+        return OpenResult::Failed;
+    }
+
+    int fd = -1;
+    StateFileLayout* map = nullptr;
+    int last_errno = 0;
+};
+
+inline const char* toString(StateFile::OpenResult r) {
+    switch(r) {
+        case StateFile::OpenResult::Created: return "created";
+        case StateFile::OpenResult::Restored: return "restored";
+        case StateFile::OpenResult::Reinitialized: return "reinitialized (incompatible layout)";
+        case StateFile::OpenResult::Locked: return "locked by another process";
+        default: return "failed";
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "fixed_point.hpp"
+#include "symbol_table.hpp"
+
+// Compile-time strategy configuration.
+// A config is a struct of constexpr members (symbol set, spread, order size, tick size)
+// passed as a template parameter, so the quoting kernel sees every parameter as a
+// constant: the spread multiply and the tick divisions fold to multiply/shift sequences,
+// and the per-symbol spread/tick/size columns are never read. Built into the market maker
+// with -DHFT_STATIC_CONFIG=ON (StrategyConfig below); the runtime-configured binary is
+// unchanged.
+//
+// Config requirements:
+//   static constexpr std::string_view SYMBOLS[];  watchlist, first one is primary
+//   static constexpr SpreadBps SPREAD;
+//   static constexpr int64_t ORDER_SIZE;
+//   static constexpr TickSize TICK;               ticks == 0 selects the default tick rule
+
+template<class Config>
+constexpr QuotePair staticQuoteAround(Price mid) {
+    if constexpr(Config::TICK.ticks != 0) {
+        return quoteAround(mid, Config::SPREAD, Config::TICK);
+    } else {
+        // Both arms of the default rule with a constant tick, rather than a runtime divisor
+        return mid.ticks >= PRICE_SCALE ? quoteAround(mid, Config::SPREAD, PENNY)
+                                        : quoteAround(mid, Config::SPREAD, SUB_PENNY);
+    }
+}
+
+template<class Config>
+constexpr size_t staticSymbolCount() {
+    return sizeof(Config::SYMBOLS) / sizeof(Config::SYMBOLS[0]);
+}
+
+// Comma-separated watchlist, as MarketMaker::setSymbol takes it.
+template<class Config>
+std::string staticSymbolList() {
+    std::string list;
+    for(std::string_view sym : Config::SYMBOLS) {
+        if(!list.empty()) list += ',';
+        list += sym;
+    }
+    return list;
+}
+
+// SymbolStateTable::computeQuotes with the strategy parameters fixed at compile time.
+template<class Config>
+void computeQuotesStatic(SymbolStateTable& table, size_t begin, size_t end) {
+    const int64_t* last = table.last.data();
+    int64_t* bid = table.our_bid.data();
+    int64_t* ask = table.our_ask.data();
+    for(size_t i = begin; i < end; ++i) {
+        Price mid{last[i]};
+        QuotePair q = mid.positive() ? staticQuoteAround<Config>(mid) : QuotePair{};
+        bid[i] = q.bid.ticks;
+        ask[i] = q.ask.ticks;
+    }
+}
+
+template<class Config>
+void computeQuotesStatic(SymbolStateTable& table) {
+    computeQuotesStatic<Config>(table, 0, table.size());
+}
+
+// The configuration compiled in with HFT_STATIC_CONFIG. Edit and rebuild to change it.
+struct StrategyConfig {
+    static constexpr std::string_view SYMBOLS[] = {"AAPL", "MSFT", "NVDA"};
+    static constexpr SpreadBps SPREAD{500};  // 5 bps
+    static constexpr int64_t ORDER_SIZE = 100;
+    static constexpr TickSize TICK{0};       // default tick rule
+};
+
+// Compile-time check that the kernel agrees with the runtime quoting rule.
+static_assert(staticQuoteAround<StrategyConfig>(Price{2'274'100}).bid ==
+              quoteAround(Price{2'274'100}, StrategyConfig::SPREAD, PENNY).bid, "static quoting diverged");
@@ -0,0 +1,142 @@
+#pragma once
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include "json_backend.hpp"
+#include "json_scan.hpp"
+#include "market_data.hpp"
+
+// Incremental JSON decoder for bulk quote and intraday responses.
+// Driven straight from curl's write callback: each chunk is appended, scanned for records
+// that became complete, and every finished record is decoded and handed to the sink
+// immediately, so the first quotes are published while the rest of the body is still in
+// flight. Only the unfinished tail is kept between chunks.
+//
+// Both endpoints put their records one level below a top-level container:
+//   bulk:     { "data": [ {record}, {record}, ... ] }
+//   intraday: { "Meta Data": {...}, "Time Series (5min)": { "ts": {record}, ... } }
+// so a record is any object that opens at depth 3. For intraday the record starts at the
+// timestamp key that precedes it.
+
+class StreamingJsonDecoder {
+public:
+    enum class Kind : uint8_t { BulkQuotes, Intraday };
+
+    using QuoteSink = std::function<void(const QuoteRecord&)>;
+    using BarSink = std::function<void(const Bar&)>;
+
+    StreamingJsonDecoder(QuoteSink sink, const JsonScanner& scanner = jsonScanner())
+        : kind(Kind::BulkQuotes), onQuote(std::move(sink)), scan(scanner) {}
+    StreamingJsonDecoder(BarSink sink, const JsonScanner& scanner = jsonScanner())
+        : kind(Kind::Intraday), onBar(std::move(sink)), scan(scanner) {}
+
+    // Prepares for a new response body.
+    void reset() {
+        buf.clear();
+        head.clear();
+        scanned = 0;
+        record_start = NONE;
+        key_start = NONE;
+        depth = 0;
+        records = 0;
+        closed = false;
+        malformed = false;
+    }
+
+    void feed(const char* data, size_t n) {
+        if(head.size() < HEAD_BYTES) head.append(data, std::min(n, HEAD_BYTES - head.size()));
+        buf.append(data, n);
+        scanBuffered();
+    }
+
+    size_t recordCount() const { return records; }
+    // True once the top-level value has closed.
+    bool finished() const { return closed; }
+    bool failed() const { return malformed; }
+    // First bytes of the body, kept for logging API errors ("Note", "Error Message").
+    const std::string& bodyHead() const { return head; }
+
+private:
+    static constexpr size_t NONE = static_cast<size_t>(-1);
+    static constexpr size_t HEAD_BYTES = 512;
+
+    void scanBuffered() {
+        const char* base = buf.data();
+        const char* end = base + buf.size();
+        StructuralCursor cur(base + scanned, end, scan);
+
+        for(;;) {
+            const char* t = cur.next();
+            if(t == end) {
+                scanned = buf.size();
+                break;
+            }
+            size_t pos = static_cast<size_t>(t - base);
+            if(*t == '"') {
+                // An unterminated string is rescanned from its opening quote next time
+                if(cur.stringEnd() == end) {
+                    scanned = pos;
+                    break;
+                }
+                if(depth == 2 && record_start == NONE) key_start = pos;
+            } else if(*t == '{' || *t == '[') {
+                ++depth;
+                if(depth == 3 && *t == '{') record_start = kind == Kind::Intraday ? key_start : pos;
+            } else if(*t == '}' || *t == ']') {
+                if(depth == 3 && *t == '}' && record_start != NONE) {
+                    publish(base + record_start, t + 1);
+                    record_start = NONE;
+                }
+                if(--depth == 0) closed = true;
+            }
+        }
+        compact();
+    }
+
+    void publish(const char* begin, const char* end) {
+        StructuralCursor cur(begin, end, scan);
+        const char* first = cur.next();
+        bool ok = false;
+        if(kind == Kind::BulkQuotes) {
+            QuoteRecord rec;
+            ok = first != end && *first == '{' && json_backend_detail::readBulkRecord(cur, rec);
+            if(ok) onQuote(rec);
+        } else {
+            Bar bar;
+            ok = first != end && *first == '"' && json_backend_detail::readBarEntry(cur, first + 1, bar);
+            if(ok) onBar(bar);
+        }
+        records += ok;
+        malformed = malformed || !ok;
+    }
+
+    // Drops bytes no future record can reference.
+    void compact() {
+        size_t keep = scanned;
+        if(record_start != NONE) keep = std::min(keep, record_start);
+        else if(depth == 2 && key_start != NONE) keep = std::min(keep, key_start);
+        if(keep == 0) return;
+
+        buf.erase(0, keep);
+        scanned -= keep;
+        if(record_start != NONE) record_start -= keep;
+        key_start = key_start != NONE && key_start >= keep ? key_start - keep : NONE;
+    }
+
+    Kind kind;
+    QuoteSink onQuote;
+    BarSink onBar;
+    const JsonScanner& scan;
+
+    std::string buf;
+    std::string head;
+    size_t scanned = 0;
+    size_t record_start = NONE;
+    size_t key_start = NONE;
+    int depth = 0;
+    size_t records = 0;
+    bool closed = false;
+    bool malformed = false;
+};
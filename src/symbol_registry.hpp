@@ -0,0 +1,110 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include "aligned.hpp"
+#include "market_data.hpp"
+
+// Interns tickers into dense SymbolIds (0, 1, 2, ...) at startup.
+// A ticker is packed into a 16-byte key (two words, zero padded), so lookup from wire data is
+// a multiply-xor hash and a two-word compare in an open-addressed, linearly probed table kept
+// at most half full. No std::string is built and no characters are hashed one at a time.
+// Everything past the registry (state table, ticks, orders, positions, metrics) keys on ids.
+
+using SymbolId = uint32_t;
+constexpr SymbolId INVALID_SYMBOL = UINT32_MAX;
+
+struct SymbolKey {
+    uint64_t lo = 0;
+    uint64_t hi = 0;
+
+    // False if sym is empty or does not fit (SYMBOL_CAPACITY - 1 characters).
+    static bool pack(std::string_view sym, SymbolKey& out) {
+        if(sym.empty() || sym.size() >= SYMBOL_CAPACITY) return false;
+        char buf[SYMBOL_CAPACITY] = {};
+        std::memcpy(buf, sym.data(), sym.size());
+        std::memcpy(&out.lo, buf, sizeof(out.lo));
+        std::memcpy(&out.hi, buf + sizeof(out.lo), sizeof(out.hi));
+        return true;
+    }
+
+    bool operator==(const SymbolKey& o) const { return lo == o.lo && hi == o.hi; }
+
+    uint64_t hash() const {
+        uint64_t h = lo * 0x9E3779B97F4A7C15ull ^ hi * 0xC2B2AE3D27D4EB4Full;
+        return h ^ (h >> 29);
+    }
+};
+
+class SymbolRegistry {
+public:
+    explicit SymbolRegistry(size_t capacity = 0) : names(capacity) {
+        size_t slotCount = 16;
+        while(slotCount < capacity * 2) slotCount <<= 1;
+        slots = AlignedArray<Slot>(slotCount);
+        for(size_t i = 0; i < slotCount; ++i) slots[i].id = INVALID_SYMBOL;
+        mask = slotCount - 1;
+    }
+
+    // Id of sym, assigning the next dense id if new. INVALID_SYMBOL when full or too long.
+    SymbolId intern(std::string_view sym) {
+        SymbolKey key;
+        if(!SymbolKey::pack(sym, key)) return INVALID_SYMBOL;
+        size_t i = key.hash() & mask;
+        for(;; i = (i + 1) & mask) {
+            if(slots[i].id == INVALID_SYMBOL) break;
+            if(slots[i].key == key) return slots[i].id;
+        }
+        if(count == names.size()) return INVALID_SYMBOL;
+
+        SymbolId id = static_cast<SymbolId>(count++);
+        slots[i].key = key;
+        slots[i].id = id;
+        names[id] = key;
+        return id;
+    }
+
+    SymbolId find(std::string_view sym) const {
+        SymbolKey key;
+        if(!SymbolKey::pack(sym, key)) return INVALID_SYMBOL;
+        return find(key);
+    }
+
+    // Lookup by an already packed key (e.g. one carried in a MarketBus tick).
+    SymbolId find(const SymbolKey& key) const {
+        for(size_t i = key.hash() & mask;; i = (i + 1) & mask) {
+            const Slot& slot = slots[i];
+            if(slot.id == INVALID_SYMBOL || slot.key == key) return slot.id;
+        }
+    }
+
+    const SymbolKey& key(SymbolId id) const { return names[id]; }
+
+    std::string_view name(SymbolId id) const {
+        const char* text = reinterpret_cast<const char*>(&names[id]);
+        return std::string_view(text, strnlen(text, SYMBOL_CAPACITY));
+    }
+
+    size_t size() const { return count; }
+    size_t capacity() const { return names.size(); }
+
+    // fn(data, bytes) for each array behind the registry (NUMA placement).
+    template<class Fn>
+    void memoryBlocks(Fn&& fn) {
+        fn(names.data(), names.bytes());
+        fn(slots.data(), slots.bytes());
+    }
+
+private:
+    struct Slot {
+        SymbolKey key;
+        SymbolId id;
+        uint32_t pad;
+    };
+
+    AlignedArray<SymbolKey> names;  // indexed by id
+    AlignedArray<Slot> slots;
+    size_t mask = 0;
+    size_t count = 0;
+};
@@ -0,0 +1,109 @@
+#pragma once
+#include <cstdint>
+#include <initializer_list>
+#include <string_view>
+
+#include "aligned.hpp"
+#include "fixed_point.hpp"
+#include "market_data.hpp"
+#include "symbol_registry.hpp"
+
+// Structure-of-arrays state for every quoted symbol.
+// Each field is its own dense, cache-line-aligned column indexed by SymbolId, so a strategy
+// or risk pass over the whole universe streams through exactly the columns it touches.
+// Prices are ticks (see fixed_point.hpp). Row ids come from the table's SymbolRegistry.
+// Single writer: the thread that owns the table.
+
+class SymbolStateTable {
+public:
+    explicit SymbolStateTable(size_t capacity = 0)
+        : last(capacity), bid(capacity), ask(capacity), volume(capacity),
+          updated_ns(capacity), spread(capacity), tick(capacity), order_size(capacity),
+          position(capacity), our_bid(capacity), our_ask(capacity), registry(capacity) {}
+
+    // Id of sym, adding it with the given quoting parameters if new. INVALID_SYMBOL when
+    // the table is full or the ticker does not fit.
+    SymbolId add(std::string_view sym, SpreadBps spreadBps, int64_t size, TickSize tickSize = TickSize{0}) {
+        size_t before = registry.size();
+        SymbolId id = registry.intern(sym);
+        if(id == INVALID_SYMBOL || registry.size() == before) return id;
+
+        spread[id] = spreadBps.centi_bps;
+        order_size[id] = size;
+        tick[id] = tickSize.ticks;
+        return id;
+    }
+
+    SymbolId find(std::string_view sym) const { return registry.find(sym); }
+    std::string_view name(SymbolId id) const { return registry.name(id); }
+    const SymbolRegistry& symbols() const { return registry; }
+
+    size_t size() const { return registry.size(); }
+    size_t capacity() const { return registry.capacity(); }
+
+    void applyQuote(SymbolId id, const QuoteRecord& rec, int64_t now_ns) {
+        if(rec.has(QuoteField::Price)) last[id] = rec.price;
+        if(rec.has(QuoteField::Low)) bid[id] = rec.low;
+        if(rec.has(QuoteField::High)) ask[id] = rec.high;
+        if(rec.has(QuoteField::Volume)) volume[id] = rec.volume;
+        updated_ns[id] = now_ns;
+    }
+
+    // Strategy pass: our bid/ask around every symbol's last price. Symbols without a price
+    // yet get zero quotes. tick == 0 means the default tick rule for the price level.
+    void computeQuotes() { computeQuotes(0, registry.size()); }
+
+    // The same over rows [begin, end); disjoint ranges can run on different threads.
+    void computeQuotes(size_t begin, size_t end) {
+        for(size_t i = begin; i < end; ++i) {
+            Price mid{last[i]};
+            if(!mid.positive()) {
+                our_bid[i] = 0;
+                our_ask[i] = 0;
+                continue;
+            }
+            TickSize t = tick[i] ? TickSize{tick[i]} : defaultTickSize(mid);
+            QuotePair q = quoteAround(mid, SpreadBps{spread[i]}, t);
+            our_bid[i] = q.bid.ticks;
+            our_ask[i] = q.ask.ticks;
+        }
+    }
+
+    Price lastPrice(SymbolId id) const { return Price{last[id]}; }
+    QuotePair ourQuote(SymbolId id) const { return QuotePair{Price{our_bid[id]}, Price{our_ask[id]}}; }
+    TickSize tickSize(SymbolId id) const { return tick[id] ? TickSize{tick[id]} : defaultTickSize(lastPrice(id)); }
+
+    // fn(data, bytes) for each column's slice of rows [begin, end), so a shard's rows can be
+    // placed on the NUMA node of the thread that quotes them.
+    template<class Fn>
+    void rowBlocks(size_t begin, size_t end, Fn&& fn) {
+        if(begin >= end) return;
+        for(AlignedArray<int64_t>* column : {&last, &bid, &ask, &volume, &updated_ns, &spread, &tick, &order_size,
+                                             &position, &our_bid, &our_ask}) {
+            fn(column->data() + begin, (end - begin) * sizeof(int64_t));
+        }
+    }
+
+    // The same for every array of the table: all columns and the registry.
+    template<class Fn>
+    void memoryBlocks(Fn&& fn) {
+        rowBlocks(0, capacity(), fn);
+        registry.memoryBlocks(fn);
+    }
+
+    // Columns, indexed by SymbolId
+    AlignedArray<int64_t> last;        // last trade price, ticks
+    AlignedArray<int64_t> bid;         // market bid, ticks
+    AlignedArray<int64_t> ask;         // market ask, ticks
+    AlignedArray<int64_t> volume;
+    AlignedArray<int64_t> updated_ns;  // steady_clock time of the last quote
+    AlignedArray<int64_t> spread;      // quoting spread, hundredths of a bp
+    AlignedArray<int64_t> tick;        // tick size in ticks, 0 = default rule
+    AlignedArray<int64_t> order_size;  // shares per order
+    AlignedArray<int64_t> position;    // signed shares held
+    AlignedArray<int64_t> our_bid;     // computed by computeQuotes, ticks
+    AlignedArray<int64_t> our_ask;
+
+private:
+    SymbolRegistry registry;
+};
@@ -0,0 +1,171 @@
+#pragma once
+#include <algorithm>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Coroutine task type for code running on a reactor thread.
+// A Task is lazy: nothing runs until start(), detach() or co_await. Awaiting a Task runs it
+// to completion and then continues the awaiting coroutine (symmetric transfer, no stack
+// growth). Frames come from a per-thread FramePool instead of the global heap, so starting
+// and finishing a coroutine in steady state costs two free-list operations.
+
+struct FramePoolStats {
+    uint64_t live = 0;         // frames currently allocated
+    uint64_t high_water = 0;
+    uint64_t chunks = 0;       // CHUNK_BYTES blocks taken from the heap
+    uint64_t oversized = 0;    // frames above the largest size class (heap allocated)
+};
+
+// Size-classed free lists of cache-line multiples. Chunks are only returned at thread exit,
+// and a frame must be destroyed on the thread that created it.
+class FramePool {
+public:
+    static constexpr size_t GRANULE = 64;
+    static constexpr size_t CLASSES = 16;             // frames up to 1 KiB
+    static constexpr size_t CHUNK_BYTES = 64 * 1024;
+
+    static FramePool& thisThread() {
+        thread_local FramePool pool;
+        return pool;
+    }
+
+    FramePool() = default;
+    FramePool(const FramePool&) = delete;
+    FramePool& operator=(const FramePool&) = delete;
+    ~FramePool() {
+        for(void* chunk : chunks) ::operator delete(chunk, std::align_val_t{GRANULE});
+    }
+
+    void* allocate(size_t n) {
+        size_t c = sizeClass(n);
+        if(c >= CLASSES) {
+            ++counters.oversized;
+            return ::operator new(n);
+        }
+        if(!free_lists[c]) refill(c);
+        FreeBlock* block = free_lists[c];
+        free_lists[c] = block->next;
+        counters.high_water = std::max(counters.high_water, ++counters.live);
+        return block;
+    }
+
+    void deallocate(void* p, size_t n) noexcept {
+        size_t c = sizeClass(n);
+        if(c >= CLASSES) {
+            ::operator delete(p);
+            return;
+        }
+        FreeBlock* block = static_cast<FreeBlock*>(p);
+        block->next = free_lists[c];
+        free_lists[c] = block;
+        --counters.live;
+    }
+
+    // Makes sure `frames` frames of n bytes can be created without touching the heap.
+    void reserve(size_t n, size_t frames) {
+        size_t c = sizeClass(n);
+        if(c >= CLASSES) return;
+        size_t have = 0;
+        for(FreeBlock* b = free_lists[c]; b && have < frames; b = b->next) ++have;
+        while(have < frames) have += refill(c);
+    }
+
+    FramePoolStats stats() const { return counters; }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    static size_t sizeClass(size_t n) { return n == 0 ? 0 : (n - 1) / GRANULE; }
+
+    size_t refill(size_t c) {
+        size_t block = (c + 1) * GRANULE;
+        size_t count = std::max<size_t>(1, CHUNK_BYTES / block);
+        char* chunk = static_cast<char*>(::operator new(block * count, std::align_val_t{GRANULE}));
+        chunks.push_back(chunk);
+        ++counters.chunks;
+        for(size_t i = count; i-- > 0;) {
+            FreeBlock* b = reinterpret_cast<FreeBlock*>(chunk + i * block);
+            b->next = free_lists[c];
+            free_lists[c] = b;
+        }
+        return count;
+    }
+
+    FreeBlock* free_lists[CLASSES] = {};
+    std::vector<void*> chunks;
+    FramePoolStats counters;
+};
+
+class [[nodiscard]] Task {
+public:
+    struct promise_type {
+        std::coroutine_handle<> continuation;
+        bool detached = false;
+
+        static void* operator new(size_t n) { return FramePool::thisThread().allocate(n); }
+        static void operator delete(void* p, size_t n) noexcept { FramePool::thisThread().deallocate(p, n); }
+
+        Task get_return_object() { return Task(Handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+                promise_type& p = h.promise();
+                std::coroutine_handle<> next = p.continuation ? p.continuation : std::noop_coroutine();
+                if(p.detached) h.destroy();
+                return next;
+            }
+            void await_resume() noexcept {}
+        };
+        FinalAwaiter final_suspend() noexcept { return {}; }
+
+        void return_void() {}
+        // Reactor handlers have nowhere to report an exception to
+        void unhandled_exception() { std::terminate(); }
+    };
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Task() = default;
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+    Task& operator=(Task&& other) noexcept {
+        if(this != &other) {
+            if(handle) handle.destroy();
+            handle = std::exchange(other.handle, {});
+        }
+        return *this;
+    }
+    // Destroying a suspended task destroys its frame; whatever it was waiting on must
+    // not resume it afterwards.
+    ~Task() {
+        if(handle) handle.destroy();
+    }
+
+    // Runs the coroutine up to its first suspension; the Task keeps ownership of the frame.
+    void start() { handle.resume(); }
+    // Starts the coroutine and lets it free its own frame when it finishes.
+    void detach() && {
+        Handle h = std::exchange(handle, {});
+        h.promise().detached = true;
+        h.resume();
+    }
+    bool done() const { return !handle || handle.done(); }
+
+    bool await_ready() const noexcept { return done(); }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+    void await_resume() noexcept {}
+
+private:
+    explicit Task(Handle h) : handle(h) {}
+    Handle handle;
+};
@@ -0,0 +1,251 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+// Hierarchical timing wheel (Varghese & Lauck): LEVELS wheels of SLOTS slots each, level l
+// covering ticks in units of SLOTS^l. A timer goes into the level of the highest tick digit
+// in which its expiry differs from the current tick, so schedule and cancel are O(1); when
+// a lower wheel wraps, the next slot of the wheel above is cascaded down. Timers are
+// intrusive TimerNodes owned by the caller, so the wheel never allocates.
+//
+// Ticks are abstract; the caller converts time to ticks (AsyncTimers uses 100 us). With
+// 4 x 256 slots the wheels span 2^32 ticks; expiries beyond the current top-level
+// rotation wait on an overflow list that is re-filed each time the top level wraps.
+
+struct TimerNode {
+    using Callback = void (*)(TimerNode*);
+
+    TimerNode() = default;
+    explicit TimerNode(Callback cb) : fire(cb) {}
+    // Copying an unscheduled node copies only its callback
+    TimerNode(const TimerNode& other) : fire(other.fire) {}
+    TimerNode& operator=(const TimerNode&) = delete;
+
+    bool scheduled() const { return next != nullptr; }
+
+    Callback fire = nullptr;
+    uint64_t expiry = 0;               // tick
+    TimerNode* prev = nullptr;
+    TimerNode* next = nullptr;
+};
+
+class TimerWheel {
+public:
+    static constexpr int LEVELS = 4;
+    static constexpr int SLOT_BITS = 8;
+    static constexpr size_t SLOTS = size_t{1} << SLOT_BITS;
+    static constexpr uint64_t HORIZON = (uint64_t{1} << (LEVELS * SLOT_BITS)) - 1;
+    static constexpr uint64_t NO_TIMER = ~uint64_t{0};
+
+    explicit TimerWheel(uint64_t start_tick = 0) : current(start_tick) {
+        for(auto& level : slots) {
+            for(TimerNode& head : level) head.prev = head.next = &head;
+        }
+        overflow.prev = overflow.next = &overflow;
+    }
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+    ~TimerWheel() { clear(); }
+
+    // (Re)schedules n to fire at expiry_tick; a tick that is already due fires on the next
+    // advance().
+    void schedule(TimerNode& n, uint64_t expiry_tick) {
+        if(n.scheduled()) unlink(n);
+        else ++count;
+        n.expiry = expiry_tick;
+        file(n);
+    }
+
+    void cancel(TimerNode& n) {
+        if(!n.scheduled()) return;
+        unlink(n);
+        --count;
+    }
+
+    // Moves the wheel to now_tick, firing every timer whose expiry is <= now_tick, tick by
+    // tick in expiry order. Callbacks may schedule and cancel timers, including the one
+    // firing. Returns the number fired.
+    size_t advance(uint64_t now_tick) {
+        // Timers filed as already due sit in the current slot
+        size_t fired = fireSlot(slotIndex(current, 0));
+        while(current < now_tick) {
+            // Jump straight to the next tick with work; the slots in between are empty
+            uint64_t next = nextTickAfterCurrent();
+            if(next > now_tick) {
+                current = now_tick;
+                break;
+            }
+            current = next;
+            if(slotIndex(current, 0) == 0) cascade(1);
+            fired += fireSlot(slotIndex(current, 0));
+        }
+        return fired;
+    }
+
+    // The earliest tick at which advance() has something to do (a level 0 expiry or a
+    // cascade of an occupied higher slot), or NO_TIMER when the wheel is empty.
+    uint64_t nextWake() const {
+        if(count == 0) return NO_TIMER;
+        if(occupied(0, slotIndex(current, 0))) return current;
+        return nextTickAfterCurrent();
+    }
+
+    // Unlinks every timer without firing it.
+    void clear() {
+        for(int l = 0; l < LEVELS; ++l) {
+            for(size_t s = 0; s < SLOTS; ++s) {
+                TimerNode& head = slots[l][s];
+                while(head.next != &head) unlink(*head.next);
+            }
+            for(uint64_t& word : bitmap[l]) word = 0;
+        }
+        while(overflow.next != &overflow) unlink(*overflow.next);
+        count = 0;
+    }
+
+    uint64_t now() const { return current; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+private:
+    static size_t slotIndex(uint64_t tick, int level) {
+        return static_cast<size_t>((tick >> (level * SLOT_BITS)) & (SLOTS - 1));
+    }
+
+    static int levelFor(uint64_t expiry, uint64_t now) {
+        uint64_t diff = expiry ^ now;
+        return diff == 0 ? 0 : (63 - std::countl_zero(diff)) / SLOT_BITS;
+    }
+
+    void file(TimerNode& n) {
+        uint64_t expiry = n.expiry > current ? n.expiry : current;
+        int level = levelFor(expiry, current);
+        if(level >= LEVELS) {
+            linkTo(overflow, n);
+            return;
+        }
+        linkTo(slots[level][slotIndex(expiry, level)], n);
+        size_t s = slotIndex(expiry, level);
+        bitmap[level][s / 64] |= uint64_t{1} << (s % 64);
+    }
+
+    static void linkTo(TimerNode& head, TimerNode& n) {
+        n.prev = head.prev;
+        n.next = &head;
+        head.prev->next = &n;
+        head.prev = &n;
+    }
+
+    void unlink(TimerNode& n) {
+        TimerNode* after = n.next;
+        n.prev->next = after;
+        after->prev = n.prev;
+        n.prev = n.next = nullptr;
+        // An emptied slot's head points at itself; clear its bit (found via the head)
+        if(after->next == after) clearIfEmpty(after);
+    }
+
+    // Heads live inside slots[][]; if p is one and its slot is empty, clear its bit.
+    void clearIfEmpty(TimerNode* p) {
+        const TimerNode* base = &slots[0][0];
+        if(p < base || p >= base + LEVELS * SLOTS) return;
+        size_t i = static_cast<size_t>(p - base);
+        bitmap[i / SLOTS][(i % SLOTS) / 64] &= ~(uint64_t{1} << (i % 64));
+    }
+
+    bool occupied(int level, size_t s) const { return (bitmap[level][s / 64] >> (s % 64)) & 1; }
+
+    // First occupied slot of `level` after the current one in this rotation, as the tick
+    // at which it is reached; NO_TIMER if there is none.
+    uint64_t nextTickWithWork(int level) const {
+        size_t from = slotIndex(current, level) + 1;
+        for(size_t w = from / 64; from < SLOTS && w < SLOTS / 64; ++w) {
+            uint64_t bits = bitmap[level][w];
+            if(w == from / 64) bits &= ~uint64_t{0} << (from % 64);
+            if(bits) {
+                uint64_t s = w * 64 + static_cast<uint64_t>(std::countr_zero(bits));
+                int shift = (level + 1) * SLOT_BITS;
+                uint64_t base = (current >> shift) << shift;
+                return base | (s << (level * SLOT_BITS));
+            }
+        }
+        return NO_TIMER;
+    }
+
+    // The first tick after the current one at which a level 0 slot fires or an occupied
+    // higher slot cascades. Lower levels always come first, so the first hit is the earliest.
+    uint64_t nextTickAfterCurrent() const {
+        if(count == 0) return NO_TIMER;
+        for(int l = 0; l < LEVELS; ++l) {
+            uint64_t t = nextTickWithWork(l);
+            if(t != NO_TIMER) return t;
+        }
+        // Only overflow timers (or already due ones) remain: wake when the top level wraps
+        return (current | HORIZON) + 1;
+    }
+
+    // Called when level l-1 wraps: re-files level l's current slot, cascading l+1 first if
+    // l wrapped too. Past the top level, the overflow list is re-filed.
+    void cascade(int level) {
+        TimerNode pending;
+        if(level >= LEVELS) {
+            if(overflow.next == &overflow) return;
+            takeList(overflow, pending);
+        } else {
+            size_t s = slotIndex(current, level);
+            if(s == 0) cascade(level + 1);
+            if(slots[level][s].next == &slots[level][s]) return;
+            takeSlot(level, s, pending);
+        }
+        while(pending.next != &pending) {
+            TimerNode& n = *pending.next;
+            unlinkPlain(n);
+            file(n);
+        }
+    }
+
+    // Fires level 0 slot s. Timers scheduled by the callbacks go into fresh lists, so a
+    // callback re-arming for a due tick fires on the next advance() rather than looping.
+    size_t fireSlot(size_t s) {
+        TimerNode& head = slots[0][s];
+        if(head.next == &head) return 0;
+        TimerNode pending;
+        takeSlot(0, s, pending);
+        size_t fired = 0;
+        while(pending.next != &pending) {
+            TimerNode& n = *pending.next;
+            unlinkPlain(n);
+            --count;
+            ++fired;
+            n.fire(&n);
+        }
+        return fired;
+    }
+
+    // Moves a whole slot onto the local list `into` and clears its bit.
+    void takeSlot(int level, size_t s, TimerNode& into) {
+        takeList(slots[level][s], into);
+        bitmap[level][s / 64] &= ~(uint64_t{1} << (s % 64));
+    }
+
+    static void takeList(TimerNode& head, TimerNode& into) {
+        into.next = head.next;
+        into.prev = head.prev;
+        into.next->prev = &into;
+        into.prev->next = &into;
+        head.prev = head.next = &head;
+    }
+
+    static void unlinkPlain(TimerNode& n) {
+        n.prev->next = n.next;
+        n.next->prev = n.prev;
+        n.prev = n.next = nullptr;
+    }
+
+    uint64_t current;
+    size_t count = 0;
+    TimerNode slots[LEVELS][SLOTS];
+    TimerNode overflow;                // expiries past the current top-level rotation
+    uint64_t bitmap[LEVELS][SLOTS / 64] = {};
+};
@@ -0,0 +1,223 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "execution.hpp"
+#include "latency_histogram.hpp"
+#include "numa.hpp"
+#include "spsc_ring.hpp"
+
+// Work-stealing pool for bursts of per-symbol strategy work.
+// One thread submits Jobs, each with an affinity key; a job goes to the inbox of worker
+// key % workers, so the same symbols keep landing on the same worker and its caches. Each
+// worker moves its inbox into its own Chase-Lev deque and runs from the bottom; a worker
+// with nothing to do steals from the top of the others' deques, and so does the
+// submitting thread while it waits for the burst to finish. Jobs are intrusive and owned
+// by the caller, so submitting allocates nothing. A pinned worker moves its own deque and
+// inbox to its NUMA node. Idle workers and the waiting submitter park on Doorbells in
+// sleep and hybrid mode, so a burst or a shutdown reaches them without a polling delay.
+
+struct Job {
+    using Fn = void (*)(Job*);
+
+    explicit Job(Fn f = nullptr) : run(f) {}
+
+    Fn run;
+    int64_t enqueued_ns = 0;
+};
+
+// Bounded Chase-Lev deque of pointers (Le et al., "Correct and efficient work-stealing for
+// weak memory models", 2013). push/pop: owner only; steal: any thread.
+template<class T>
+class StealingDeque {
+public:
+    explicit StealingDeque(size_t capacity) : slots(new std::atomic<T*>[roundUp(capacity)]), mask(roundUp(capacity) - 1) {}
+
+    bool push(T* item) {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_acquire);
+        if(b - t > static_cast<int64_t>(mask)) return false;
+        slots[static_cast<size_t>(b) & mask].store(item, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    T* pop() {
+        int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+        if(t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        T* item = slots[static_cast<size_t>(b) & mask].load(std::memory_order_relaxed);
+        if(t == b) {
+            // Last item: race the thieves for it
+            if(!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) item = nullptr;
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    T* steal() {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom.load(std::memory_order_acquire);
+        if(t >= b) return nullptr;
+        T* item = slots[static_cast<size_t>(t) & mask].load(std::memory_order_relaxed);
+        if(!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) return nullptr;
+        return item;
+    }
+
+    // fn(data, bytes) for the slot array (NUMA placement).
+    template<class Fn>
+    void memoryBlocks(Fn&& fn) { fn(slots.get(), (mask + 1) * sizeof(std::atomic<T*>)); }
+
+private:
+    static size_t roundUp(size_t n) {
+        size_t p = 2;
+        while(p < n) p <<= 1;
+        return p;
+    }
+
+    alignas(64) std::atomic<int64_t> top{0};
+    alignas(64) std::atomic<int64_t> bottom{0};
+    std::unique_ptr<std::atomic<T*>[]> slots;
+    size_t mask;
+};
+
+struct WorkerStats {
+    uint64_t executed = 0;
+    uint64_t stolen = 0;             // of executed, taken from another worker's deque
+    LatencyHistogram latency;        // submit -> start of run, ns
+};
+
+class WorkStealingPool {
+public:
+    static constexpr size_t QUEUE_CAPACITY = 4096;
+
+    // cpus[i], when present and >= 0, pins worker i.
+    explicit WorkStealingPool(size_t workers, WaitMode mode = WaitMode::Sleep, const std::vector<int>& cpus = {})
+        : wait_mode(mode) {
+        for(size_t i = 0; i < workers; ++i) pool.push_back(std::make_unique<Worker>());
+        for(size_t i = 0; i < workers; ++i) {
+            int cpu = i < cpus.size() ? cpus[i] : -1;
+            pool[i]->thread = std::thread([this, i, cpu] {
+                if(cpu >= 0 && pinThisThread(cpu) == 0) placeLocally(*pool[i]);
+                workerLoop(i);
+            });
+        }
+    }
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+    ~WorkStealingPool() {
+        stopping.store(true, std::memory_order_release);
+        for(auto& w : pool) w->bell.ring();
+        for(auto& w : pool) w->thread.join();
+    }
+
+    size_t workers() const { return pool.size(); }
+
+    // Submitting thread only. Blocks briefly if the owner's inbox is full.
+    void submit(Job& job, size_t key) {
+        job.enqueued_ns = nowNs();
+        pending.fetch_add(1, std::memory_order_relaxed);
+        Worker& owner = *pool[key % pool.size()];
+        owner.inbox.push(&job, OverflowPolicy::Block);
+        owner.bell.ring();
+    }
+
+    // Submitting thread only: runs stolen jobs until everything submitted has finished.
+    // Wakes every worker first, so idle ones come and steal.
+    void wait() {
+        for(auto& w : pool) w->bell.ring();
+        Waiter waiter(wait_mode);
+        size_t victim = 0;
+        auto finished = [this] { return pending.load(std::memory_order_acquire) == 0; };
+        while(!finished()) {
+            Job* job = nullptr;
+            for(size_t n = 0; n < pool.size() && !job; ++n) job = pool[victim++ % pool.size()]->deque.steal();
+            if(!job) {
+                waiter.idle(done, finished);
+                continue;
+            }
+            waiter.reset();
+            ++caller.stolen;
+            execute(job, caller);
+        }
+    }
+
+    // Per-worker counters, then the submitting thread's. Read after wait().
+    const WorkerStats& workerStats(size_t i) const { return pool[i]->stats; }
+    const WorkerStats& callerStats() const { return caller; }
+    void resetStats() {
+        for(auto& w : pool) w->stats = WorkerStats{};
+        caller = WorkerStats{};
+    }
+
+private:
+    struct alignas(64) Worker {
+        StealingDeque<Job> deque{QUEUE_CAPACITY};
+        SpscRing<Job*> inbox{QUEUE_CAPACITY};
+        Doorbell bell;                 // rung by submit, wait and the destructor
+        WorkerStats stats;
+        std::thread thread;
+    };
+
+    static int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static void placeLocally(Worker& w) {
+        int node = currentNumaNode();
+        auto bind = [node](void* p, size_t bytes) { bindToNode(p, bytes, node); };
+        w.deque.memoryBlocks(bind);
+        w.inbox.memoryBlocks(bind);
+    }
+
+    void execute(Job* job, WorkerStats& stats) {
+        stats.latency.record(nowNs() - job->enqueued_ns);
+        job->run(job);
+        ++stats.executed;
+        if(pending.fetch_sub(1, std::memory_order_acq_rel) == 1) done.ring();
+    }
+
+    void workerLoop(size_t self) {
+        Worker& me = *pool[self];
+        Waiter waiter(wait_mode);
+        auto woken = [this, &me] { return me.inbox.depth() > 0 || stopping.load(std::memory_order_acquire); };
+        while(!stopping.load(std::memory_order_acquire)) {
+            // Own jobs first: the inbox feeds the deque, which thieves can see
+            Job* job = nullptr;
+            while(me.inbox.pop(job)) {
+                if(!me.deque.push(job)) execute(job, me.stats);
+            }
+            job = me.deque.pop();
+            bool stolen = false;
+            for(size_t n = 1; n < pool.size() && !job; ++n) {
+                job = pool[(self + n) % pool.size()]->deque.steal();
+                stolen = job != nullptr;
+            }
+            if(!job) {
+                waiter.idle(me.bell, woken);
+                continue;
+            }
+            waiter.reset();
+            if(stolen) ++me.stats.stolen;
+            execute(job, me.stats);
+        }
+    }
+
+    WaitMode wait_mode;
+    std::vector<std::unique_ptr<Worker>> pool;
+    std::atomic<bool> stopping{false};
+    alignas(64) std::atomic<int64_t> pending{0};
+    Doorbell done;                     // rung when pending drops to zero
+    WorkerStats caller;
+};